@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <devacademy/bench.h>
+
+struct bench_result {
+	const struct bench_kernel *kernel;
+	struct bench_stats stats;
+	uint32_t checksum;
+};
+
+static uint64_t samples[CONFIG_DEVACADEMY_BENCH_REPETITIONS];
+static struct bench_result results[CONFIG_DEVACADEMY_BENCH_MAX_KERNELS];
+static size_t result_count;
+
+/* Keeps the kernel results alive */
+static volatile uint32_t sink;
+
+#if defined(CONFIG_DEVACADEMY_BENCH_CLOCK_TIMING)
+
+typedef timing_t bench_time_t;
+
+static inline bench_time_t bench_now(void)
+{
+	return timing_counter_get();
+}
+
+static inline uint64_t bench_elapsed(bench_time_t *start, bench_time_t *end)
+{
+	return timing_cycles_get(start, end);
+}
+
+uint64_t bench_cycles_to_ns(uint64_t cycles)
+{
+	return timing_cycles_to_ns(cycles);
+}
+
+static uint64_t bench_clock_hz(void)
+{
+	return timing_freq_get();
+}
+
+#else
+
+typedef uint64_t bench_time_t;
+
+static inline bench_time_t bench_now(void)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+	return k_cycle_get_64();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static inline uint64_t bench_elapsed(bench_time_t *start, bench_time_t *end)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+	return *end - *start;
+#else
+	return (uint32_t)(*end - *start);
+#endif
+}
+
+uint64_t bench_cycles_to_ns(uint64_t cycles)
+{
+	return k_cyc_to_ns_floor64(cycles);
+}
+
+static uint64_t bench_clock_hz(void)
+{
+	return sys_clock_hw_cycles_per_sec();
+}
+
+#endif /* CONFIG_DEVACADEMY_BENCH_CLOCK_TIMING */
+
+static int sample_cmp(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static size_t nearest_rank(size_t count, unsigned int pct)
+{
+	size_t rank = DIV_ROUND_UP(count * pct, 100U);
+
+	return MAX(rank, 1U) - 1;
+}
+
+void bench_stats_compute(uint64_t *samples, size_t count, struct bench_stats *stats)
+{
+	uint64_t sum = 0;
+
+	qsort(samples, count, sizeof(samples[0]), sample_cmp);
+
+	for (size_t i = 0; i < count; i++) {
+		sum += samples[i];
+	}
+
+	stats->min = samples[0];
+	stats->median = samples[nearest_rank(count, 50)];
+	stats->p99 = samples[nearest_rank(count, 99)];
+	stats->max = samples[count - 1];
+	stats->mean = sum / count;
+}
+
+static uint32_t kernel_run_timed(const struct bench_kernel *kernel, uint64_t *cycles)
+{
+	bench_time_t start, end;
+	unsigned int key = 0;
+	uint32_t ret;
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_BENCH_IRQ_LOCK)) {
+		key = irq_lock();
+	}
+
+	start = bench_now();
+	ret = kernel->fn(kernel->arg);
+	end = bench_now();
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_BENCH_IRQ_LOCK)) {
+		irq_unlock(key);
+	}
+
+	*cycles = bench_elapsed(&start, &end);
+
+	return ret;
+}
+
+static void kernel_bench(const struct bench_kernel *kernel, struct bench_result *result)
+{
+	uint32_t checksum = 0;
+
+	for (int i = 0; i < CONFIG_DEVACADEMY_BENCH_WARMUP; i++) {
+		sink = kernel->fn(kernel->arg);
+	}
+
+	for (int i = 0; i < CONFIG_DEVACADEMY_BENCH_REPETITIONS; i++) {
+		checksum ^= kernel_run_timed(kernel, &samples[i]);
+	}
+
+	sink = checksum;
+
+	result->kernel = kernel;
+	result->checksum = checksum;
+	bench_stats_compute(samples, CONFIG_DEVACADEMY_BENCH_REPETITIONS, &result->stats);
+}
+
+static void summary_print_csv(size_t count)
+{
+	printk("kernel,arg,repetitions,min_cycles,median_cycles,p99_cycles,max_cycles,"
+	       "mean_cycles,min_ns,median_ns,p99_ns,checksum\n");
+
+	for (size_t i = 0; i < count; i++) {
+		const struct bench_result *r = &results[i];
+
+		printk("%s,%u,%u,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,0x%08x\n",
+		       r->kernel->name, r->kernel->arg, CONFIG_DEVACADEMY_BENCH_REPETITIONS,
+		       r->stats.min, r->stats.median, r->stats.p99, r->stats.max, r->stats.mean,
+		       bench_cycles_to_ns(r->stats.min), bench_cycles_to_ns(r->stats.median),
+		       bench_cycles_to_ns(r->stats.p99), r->checksum);
+	}
+}
+
+static void summary_print_json(size_t count)
+{
+	printk("{\"board\":\"%s\",\"clock_hz\":%llu,\"warmup\":%u,\"repetitions\":%u,"
+	       "\"kernels\":[", CONFIG_BOARD_TARGET, bench_clock_hz(), CONFIG_DEVACADEMY_BENCH_WARMUP,
+	       CONFIG_DEVACADEMY_BENCH_REPETITIONS);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct bench_result *r = &results[i];
+
+		printk("%s{\"name\":\"%s\",\"arg\":%u,\"min\":%llu,\"median\":%llu,\"p99\":%llu,"
+		       "\"max\":%llu,\"mean\":%llu,\"median_ns\":%llu,\"checksum\":%u}",
+		       (i > 0) ? "," : "", r->kernel->name, r->kernel->arg, r->stats.min,
+		       r->stats.median, r->stats.p99, r->stats.max, r->stats.mean,
+		       bench_cycles_to_ns(r->stats.median), r->checksum);
+	}
+
+	printk("]}\n");
+}
+
+int bench_run_all(void)
+{
+	size_t count = 0;
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_BENCH_CLOCK_TIMING)) {
+		timing_init();
+		timing_start();
+	}
+
+	STRUCT_SECTION_FOREACH(bench_kernel, kernel) {
+		if (count == ARRAY_SIZE(results)) {
+			printk("Too many benchmark kernels, increase "
+			       "CONFIG_DEVACADEMY_BENCH_MAX_KERNELS\n");
+			return -ENOMEM;
+		}
+
+		kernel_bench(kernel, &results[count]);
+		count++;
+	}
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_BENCH_CLOCK_TIMING)) {
+		timing_stop();
+	}
+
+	result_count = count;
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_BENCH_OUTPUT_JSON)) {
+		summary_print_json(count);
+	} else {
+		summary_print_csv(count);
+	}
+
+	return 0;
+}
+
+const struct bench_stats *bench_result_get(const char *name)
+{
+	for (size_t i = 0; i < result_count; i++) {
+		if (strcmp(results[i].kernel->name, name) == 0) {
+			return &results[i].stats;
+		}
+	}
+
+	return NULL;
+}
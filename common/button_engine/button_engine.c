@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Button event engine.
+ *
+ * The input callback only timestamps the key events and queues them. All the
+ * state lives in the engine thread, which drains every queued input event
+ * before evaluating the debounce, long press, repeat and chord deadlines, so a
+ * burst of edges from a bouncing button is handled in one pass and produces at
+ * most one press or release per button.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/input/input.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include <devacademy/button_engine.h>
+
+#define MAX_BUTTONS  CONFIG_DEVACADEMY_BUTTON_ENGINE_MAX_BUTTONS
+#define NO_DEADLINE  INT64_MAX
+
+struct raw_event {
+	int64_t timestamp;
+	uint8_t button;
+	uint8_t pressed;
+};
+
+K_MSGQ_DEFINE(raw_queue, sizeof(struct raw_event), CONFIG_DEVACADEMY_BUTTON_ENGINE_RAW_QUEUE_SIZE,
+	      4);
+K_MSGQ_DEFINE(event_queue, sizeof(struct button_event),
+	      CONFIG_DEVACADEMY_BUTTON_ENGINE_QUEUE_SIZE, 8);
+
+static atomic_t dropped;
+static atomic_t stable_state;
+
+/* Engine thread state */
+static uint32_t raw_state;
+static int64_t edge_time[MAX_BUTTONS];
+static int64_t debounce_deadline[MAX_BUTTONS];
+static int64_t hold_deadline[MAX_BUTTONS];
+static uint32_t long_press_sent;
+static int64_t chord_deadline = NO_DEADLINE;
+static uint32_t chord_mask;
+
+static int button_from_code(uint16_t code)
+{
+	if (code == INPUT_KEY_0) {
+		return 0;
+	} else if (code >= INPUT_KEY_1 && code <= INPUT_KEY_9) {
+		return code - INPUT_KEY_1 + 1;
+	} else if (code >= INPUT_BTN_0 && code <= INPUT_BTN_9) {
+		return code - INPUT_BTN_0;
+	}
+
+	return -1;
+}
+
+static void button_engine_input_cb(struct input_event *evt, void *user_data)
+{
+	struct raw_event raw;
+	int button;
+
+	if (evt->type != INPUT_EV_KEY) {
+		return;
+	}
+
+	button = button_from_code(evt->code);
+	if (button < 0 || button >= MAX_BUTTONS) {
+		return;
+	}
+
+	raw.timestamp = k_uptime_get();
+	raw.button = button;
+	raw.pressed = evt->value ? 1 : 0;
+
+	if (k_msgq_put(&raw_queue, &raw, K_NO_WAIT) != 0) {
+		atomic_inc(&dropped);
+	}
+}
+
+INPUT_CALLBACK_DEFINE(NULL, button_engine_input_cb, NULL);
+
+static void event_emit(enum button_event_type type, uint32_t buttons, int64_t timestamp)
+{
+	struct button_event evt = {
+		.timestamp = timestamp,
+		.buttons = buttons,
+		.state = atomic_get(&stable_state),
+		.type = type,
+	};
+
+	if (k_msgq_put(&event_queue, &evt, K_NO_WAIT) != 0) {
+		atomic_inc(&dropped);
+	}
+}
+
+static void raw_event_handle(const struct raw_event *raw)
+{
+	WRITE_BIT(raw_state, raw->button, raw->pressed);
+	edge_time[raw->button] = raw->timestamp;
+	debounce_deadline[raw->button] =
+		raw->timestamp + CONFIG_DEVACADEMY_BUTTON_ENGINE_DEBOUNCE_MS;
+}
+
+static void button_commit(uint8_t button)
+{
+	uint32_t mask = BIT(button);
+	bool pressed = (raw_state & mask) != 0;
+
+	if (pressed == ((atomic_get(&stable_state) & mask) != 0)) {
+		/* Bounced back to the reported state */
+		return;
+	}
+
+	if (pressed) {
+		atomic_or(&stable_state, mask);
+		long_press_sent &= ~mask;
+		event_emit(BUTTON_EVT_PRESS, mask, edge_time[button]);
+
+		if (CONFIG_DEVACADEMY_BUTTON_ENGINE_LONG_PRESS_MS > 0) {
+			hold_deadline[button] =
+				edge_time[button] + CONFIG_DEVACADEMY_BUTTON_ENGINE_LONG_PRESS_MS;
+		}
+
+		if (CONFIG_DEVACADEMY_BUTTON_ENGINE_CHORD_WINDOW_MS > 0) {
+			if (chord_deadline == NO_DEADLINE) {
+				chord_mask = 0;
+				chord_deadline = edge_time[button] +
+						 CONFIG_DEVACADEMY_BUTTON_ENGINE_CHORD_WINDOW_MS;
+			}
+			chord_mask |= mask;
+		}
+	} else {
+		atomic_and(&stable_state, ~mask);
+		hold_deadline[button] = NO_DEADLINE;
+		event_emit(BUTTON_EVT_RELEASE, mask, edge_time[button]);
+	}
+}
+
+static void deadlines_process(int64_t now)
+{
+	for (uint8_t i = 0; i < MAX_BUTTONS; i++) {
+		if (debounce_deadline[i] <= now) {
+			debounce_deadline[i] = NO_DEADLINE;
+			button_commit(i);
+		}
+
+		if (hold_deadline[i] <= now) {
+			bool repeat = (long_press_sent & BIT(i)) != 0;
+
+			long_press_sent |= BIT(i);
+			event_emit(repeat ? BUTTON_EVT_REPEAT : BUTTON_EVT_LONG_PRESS, BIT(i),
+				   hold_deadline[i]);
+
+			if (CONFIG_DEVACADEMY_BUTTON_ENGINE_REPEAT_MS > 0) {
+				hold_deadline[i] += CONFIG_DEVACADEMY_BUTTON_ENGINE_REPEAT_MS;
+			} else {
+				hold_deadline[i] = NO_DEADLINE;
+			}
+		}
+	}
+
+	if (chord_deadline <= now) {
+		uint32_t held = chord_mask & atomic_get(&stable_state);
+
+		if (POPCOUNT(held) >= 2) {
+			event_emit(BUTTON_EVT_CHORD, held, chord_deadline);
+		}
+
+		chord_deadline = NO_DEADLINE;
+		chord_mask = 0;
+	}
+}
+
+static k_timeout_t next_timeout(void)
+{
+	int64_t next = chord_deadline;
+
+	for (uint8_t i = 0; i < MAX_BUTTONS; i++) {
+		next = MIN(next, debounce_deadline[i]);
+		next = MIN(next, hold_deadline[i]);
+	}
+
+	if (next == NO_DEADLINE) {
+		return K_FOREVER;
+	}
+
+	return K_MSEC(MAX(next - k_uptime_get(), 0));
+}
+
+static void button_engine_thread(void *unused1, void *unused2, void *unused3)
+{
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
+
+	struct raw_event raw;
+
+	for (uint8_t i = 0; i < MAX_BUTTONS; i++) {
+		debounce_deadline[i] = NO_DEADLINE;
+		hold_deadline[i] = NO_DEADLINE;
+	}
+
+	while (1) {
+		if (k_msgq_get(&raw_queue, &raw, next_timeout()) == 0) {
+			raw_event_handle(&raw);
+
+			/* Coalesce everything that arrived in the meantime */
+			while (k_msgq_get(&raw_queue, &raw, K_NO_WAIT) == 0) {
+				raw_event_handle(&raw);
+			}
+		}
+
+		deadlines_process(k_uptime_get());
+	}
+}
+
+K_THREAD_DEFINE(button_engine, CONFIG_DEVACADEMY_BUTTON_ENGINE_STACK_SIZE, button_engine_thread,
+		NULL, NULL, NULL, CONFIG_DEVACADEMY_BUTTON_ENGINE_THREAD_PRIORITY, 0, 0);
+
+size_t button_engine_batch_get(struct button_event *events, size_t max, k_timeout_t timeout)
+{
+	size_t count = 0;
+
+	if (max == 0 || k_msgq_get(&event_queue, &events[0], timeout) != 0) {
+		return 0;
+	}
+
+	count++;
+
+	while (count < max && k_msgq_get(&event_queue, &events[count], K_NO_WAIT) == 0) {
+		count++;
+	}
+
+	return count;
+}
+
+uint32_t button_engine_state_get(void)
+{
+	return atomic_get(&stable_state);
+}
+
+uint32_t button_engine_dropped_get(void)
+{
+	return atomic_get(&dropped);
+}
@@ -0,0 +1,75 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+# Code shared between the course samples.
+# Include this file from the sample CMakeLists.txt after find_package(Zephyr)
+# and source common/Kconfig from the sample Kconfig file. Samples using the
+# devicetree bindings in common/dts must also append this directory to DTS_ROOT
+# before find_package(Zephyr).
+
+zephyr_include_directories(${CMAKE_CURRENT_LIST_DIR}/include)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_LOG_COST app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/log/log_cost.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_THREAD_STATS app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/thread_stats/thread_stats.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_BUTTON_ENGINE app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/button_engine/button_engine.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_SHM_RING app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/shm_ring/shm_ring.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_REMOTE_CONSOLE_BACKEND app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/remote_console/remote_console_backend.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_REMOTE_CONSOLE app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/remote_console/remote_console.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_DELTA app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/delta/delta.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_DELTA_IMG_MGMT app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/delta/delta_img_mgmt.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_LZ4 app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/lz4/lz4_stream.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_LZ4_IMG_MGMT app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/lz4/lz4_img_mgmt.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_SMP_RAW app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/smp_raw/smp_raw_uart.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_FLASH_COALESCE app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/flash_coalesce/flash_coalesce.c
+)
+
+target_sources_ifdef(CONFIG_DEVACADEMY_FLASH_COALESCE_DFU app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/flash_coalesce/flash_coalesce_dfu.c
+)
+
+if(CONFIG_DEVACADEMY_BENCH)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/bench/bench.c)
+  zephyr_linker_sources(SECTIONS ${CMAKE_CURRENT_LIST_DIR}/bench/bench-sections-rom.ld)
+endif()
+
+if(CONFIG_DEVACADEMY_PROF)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/prof/prof.c)
+  zephyr_linker_sources(DATA_SECTIONS ${CMAKE_CURRENT_LIST_DIR}/prof/prof-sections-ram.ld)
+endif()
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Streaming delta patch applier, see devacademy/delta.h for the format.
+ *
+ * The patch is parsed one byte at a time except for the bytes of insert
+ * commands, which are written straight from the input. Copy commands are
+ * carried out as soon as their length is known, through the buffer of the
+ * context. The new image is hashed as it is written.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <devacademy/delta.h>
+
+LOG_MODULE_REGISTER(delta, CONFIG_DEVACADEMY_DELTA_LOG_LEVEL);
+
+#define SHA256_SIZE	32
+#define OLD_HASH_OFFSET 8
+#define NEW_SIZE_OFFSET (OLD_HASH_OFFSET + SHA256_SIZE)
+#define NEW_HASH_OFFSET (NEW_SIZE_OFFSET + 4)
+
+#define OP_END		0x00
+#define OP_COPY		0x01
+#define OP_INSERT	0x02
+
+enum delta_state {
+	STATE_HEADER,
+	STATE_OP,
+	STATE_COPY_OFFSET,
+	STATE_COPY_LEN,
+	STATE_INSERT_LEN,
+	STATE_INSERT,
+	STATE_END,
+};
+
+static int output(struct delta_ctx *ctx, const uint8_t *data, size_t len)
+{
+	int err;
+
+	if (len > ctx->new_size - ctx->written) {
+		LOG_ERR("Patch writes past the end of the new image");
+		return -EINVAL;
+	}
+
+	err = ctx->write_new(ctx->user, data, len);
+	if (err) {
+		return err;
+	}
+
+	ctx->written += len;
+
+	return (psa_hash_update(&ctx->hash, data, len) == PSA_SUCCESS) ? 0 : -EIO;
+}
+
+static int old_hash_check(struct delta_ctx *ctx)
+{
+	psa_hash_operation_t op = PSA_HASH_OPERATION_INIT;
+	uint8_t hash[SHA256_SIZE];
+	size_t hash_len;
+	psa_status_t status;
+	int err = 0;
+
+	status = psa_hash_setup(&op, PSA_ALG_SHA_256);
+
+	for (uint32_t off = 0; off < ctx->old_size && status == PSA_SUCCESS; ) {
+		size_t len = MIN(sizeof(ctx->buf), ctx->old_size - off);
+
+		err = ctx->read_old(ctx->user, off, ctx->buf, len);
+		if (err) {
+			psa_hash_abort(&op);
+			return err;
+		}
+
+		status = psa_hash_update(&op, ctx->buf, len);
+		off += len;
+	}
+
+	if (status == PSA_SUCCESS) {
+		status = psa_hash_finish(&op, hash, sizeof(hash), &hash_len);
+	}
+
+	if (status != PSA_SUCCESS) {
+		psa_hash_abort(&op);
+		return -EIO;
+	}
+
+	if (memcmp(hash, &ctx->hdr[OLD_HASH_OFFSET], SHA256_SIZE) != 0) {
+		LOG_ERR("Patch made against another image");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int copy(struct delta_ctx *ctx, uint32_t len)
+{
+	uint32_t off = ctx->copy_offset;
+	int err;
+
+	if (off > ctx->old_size || len > ctx->old_size - off) {
+		LOG_ERR("Copy of %u bytes at %u outside the current image", len, off);
+		return -EINVAL;
+	}
+
+	while (len > 0) {
+		size_t piece = MIN(sizeof(ctx->buf), len);
+
+		err = ctx->read_old(ctx->user, off, ctx->buf, piece);
+		if (!err) {
+			err = output(ctx, ctx->buf, piece);
+		}
+		if (err) {
+			return err;
+		}
+
+		off += piece;
+		len -= piece;
+	}
+
+	ctx->copy_end = off;
+	ctx->copied += off - ctx->copy_offset;
+
+	return 0;
+}
+
+/* Accumulate a varint, returns true once complete */
+static bool varint_put(struct delta_ctx *ctx, uint8_t byte, int *err)
+{
+	if (ctx->varint_shift > 28 || (ctx->varint_shift == 28 && (byte & 0x70))) {
+		LOG_ERR("Varint overflow");
+		*err = -EINVAL;
+		return false;
+	}
+
+	ctx->varint |= (uint32_t)(byte & 0x7f) << ctx->varint_shift;
+	ctx->varint_shift += 7;
+
+	if (byte & 0x80) {
+		return false;
+	}
+
+	ctx->varint_shift = 0;
+
+	return true;
+}
+
+static int op_start(struct delta_ctx *ctx, uint8_t op)
+{
+	switch (op) {
+	case OP_END:
+		ctx->state = STATE_END;
+		return 0;
+	case OP_COPY:
+		ctx->state = STATE_COPY_OFFSET;
+		break;
+	case OP_INSERT:
+		ctx->state = STATE_INSERT_LEN;
+		break;
+	default:
+		LOG_ERR("Unknown opcode 0x%02x", op);
+		return -EINVAL;
+	}
+
+	ctx->varint = 0;
+
+	return 0;
+}
+
+/* One byte of a command that is not insert data */
+static int command_put(struct delta_ctx *ctx, uint8_t byte)
+{
+	uint32_t value;
+	int err = 0;
+
+	if (ctx->state == STATE_OP) {
+		return op_start(ctx, byte);
+	}
+
+	if (!varint_put(ctx, byte, &err)) {
+		return err;
+	}
+
+	value = ctx->varint;
+	ctx->varint = 0;
+
+	switch (ctx->state) {
+	case STATE_COPY_OFFSET:
+		/* zigzag */
+		ctx->copy_offset = ctx->copy_end + (int32_t)((value >> 1) ^ -(value & 1));
+		ctx->state = STATE_COPY_LEN;
+		break;
+	case STATE_COPY_LEN:
+		ctx->state = STATE_OP;
+		err = copy(ctx, value);
+		break;
+	case STATE_INSERT_LEN:
+		ctx->insert_left = value;
+		ctx->state = (value > 0) ? STATE_INSERT : STATE_OP;
+		break;
+	default:
+		err = -EINVAL;
+		break;
+	}
+
+	return err;
+}
+
+static int header_put(struct delta_ctx *ctx, const uint8_t *data, size_t len)
+{
+	memcpy(&ctx->hdr[ctx->hdr_len], data, len);
+	ctx->hdr_len += len;
+
+	if (ctx->hdr_len < DELTA_HDR_SIZE) {
+		return 0;
+	}
+
+	if (!delta_is_patch(ctx->hdr, ctx->hdr_len)) {
+		LOG_ERR("Not a patch");
+		return -EINVAL;
+	}
+
+	ctx->old_size = sys_get_le32(&ctx->hdr[4]);
+	ctx->new_size = sys_get_le32(&ctx->hdr[NEW_SIZE_OFFSET]);
+	ctx->state = STATE_OP;
+
+	LOG_INF("Patch from a %u byte image to a %u byte image", ctx->old_size, ctx->new_size);
+
+	return old_hash_check(ctx);
+}
+
+bool delta_is_patch(const uint8_t *data, size_t len)
+{
+	return len >= 4 && memcmp(data, DELTA_MAGIC, 4) == 0;
+}
+
+int delta_init(struct delta_ctx *ctx, delta_read_t read_old, delta_write_t write_new,
+	       void *user)
+{
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->read_old = read_old;
+	ctx->write_new = write_new;
+	ctx->user = user;
+	ctx->state = STATE_HEADER;
+	ctx->hash = psa_hash_operation_init();
+
+	if (psa_crypto_init() != PSA_SUCCESS ||
+	    psa_hash_setup(&ctx->hash, PSA_ALG_SHA_256) != PSA_SUCCESS) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int delta_feed(struct delta_ctx *ctx, const uint8_t *data, size_t len)
+{
+	size_t n;
+	int err = 0;
+
+	while (len > 0 && !err) {
+		switch (ctx->state) {
+		case STATE_HEADER:
+			n = MIN(len, DELTA_HDR_SIZE - ctx->hdr_len);
+			err = header_put(ctx, data, n);
+			break;
+		case STATE_INSERT:
+			n = MIN(len, ctx->insert_left);
+			err = output(ctx, data, n);
+			ctx->inserted += n;
+			ctx->insert_left -= n;
+			if (ctx->insert_left == 0) {
+				ctx->state = STATE_OP;
+			}
+			break;
+		case STATE_END:
+			LOG_ERR("Data after the end of the patch");
+			return -EINVAL;
+		default:
+			n = 1;
+			err = command_put(ctx, *data);
+			break;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	return err;
+}
+
+int delta_finish(struct delta_ctx *ctx)
+{
+	uint8_t hash[SHA256_SIZE];
+	size_t hash_len;
+
+	if (ctx->state != STATE_END || ctx->written != ctx->new_size) {
+		LOG_ERR("Patch incomplete, %u of %u bytes written", ctx->written, ctx->new_size);
+		delta_abort(ctx);
+		return -EBADMSG;
+	}
+
+	if (psa_hash_finish(&ctx->hash, hash, sizeof(hash), &hash_len) != PSA_SUCCESS) {
+		delta_abort(ctx);
+		return -EIO;
+	}
+
+	if (memcmp(hash, &ctx->hdr[NEW_HASH_OFFSET], SHA256_SIZE) != 0) {
+		LOG_ERR("Hash of the new image differs");
+		return -EBADMSG;
+	}
+
+	LOG_INF("New image of %u bytes: %u copied, %u inserted", ctx->written, ctx->copied,
+		ctx->inserted);
+
+	return 0;
+}
+
+void delta_abort(struct delta_ctx *ctx)
+{
+	(void)psa_hash_abort(&ctx->hash);
+}
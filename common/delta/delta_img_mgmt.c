@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* mcumgr group uploading delta patches made by scripts/delta_diff.py.
+ *
+ * Command 0 (write): {"off": uint, "data": bstr, "len": uint on the first
+ * chunk} returns {"off": uint}, the offset of the next chunk expected.
+ *
+ * Like the image upload of the image management group, but the chunks are
+ * applied to the image in the primary slot and the new image is written to
+ * the secondary slot as they arrive. The last response also holds
+ * {"size": uint, "ms": uint}, the new image size and the time since the
+ * first chunk. The image is then marked for test with the image management
+ * group, and MCUboot validates it as any other upload.
+ *
+ * An interrupted upload starts again from offset 0, the state of the patch
+ * is not kept. scripts/dfu_bench.py implements the client side.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/mgmt/handlers.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <mgmt/mcumgr/util/zcbor_bulk.h>
+#include <devacademy/delta.h>
+
+LOG_MODULE_REGISTER(delta_img_mgmt, CONFIG_DEVACADEMY_DELTA_LOG_LEVEL);
+
+#define DELTA_IMG_MGMT_GROUP_ID	(MGMT_GROUP_ID_PERUSER + 2)
+#define DELTA_IMG_MGMT_ID_UPLOAD	0
+
+#define OLD_PARTITION_ID	FIXED_PARTITION_ID(slot0_partition)
+
+static struct {
+	struct flash_img_context flash;
+	const struct flash_area *old_fa;
+	struct delta_ctx patch;
+	bool active;
+	/* Patch size and offset of the next chunk */
+	uint32_t len;
+	uint32_t off;
+	int64_t start;
+} upload;
+
+static int image_read_old(void *user, uint32_t offset, uint8_t *buf, size_t len)
+{
+	return flash_area_read(upload.old_fa, offset, buf, len);
+}
+
+static int image_write(void *user, const uint8_t *data, size_t len)
+{
+	return flash_img_buffered_write(&upload.flash, data, len, false);
+}
+
+static void upload_abort(void)
+{
+	if (upload.active) {
+		delta_abort(&upload.patch);
+		upload.active = false;
+	}
+}
+
+static int upload_start(uint32_t len)
+{
+	int err;
+
+	upload_abort();
+
+	if (!upload.old_fa) {
+		err = flash_area_open(OLD_PARTITION_ID, &upload.old_fa);
+		if (err) {
+			LOG_ERR("flash_area_open, error: %d", err);
+			return err;
+		}
+	}
+
+	err = flash_img_init(&upload.flash);
+	if (err) {
+		LOG_ERR("flash_img_init, error: %d", err);
+		return err;
+	}
+
+	err = delta_init(&upload.patch, image_read_old, image_write, NULL);
+	if (err) {
+		LOG_ERR("delta_init, error: %d", err);
+		return err;
+	}
+
+	upload.len = len;
+	upload.off = 0;
+	upload.start = k_uptime_get();
+	upload.active = true;
+
+	LOG_INF("Upload of a %u byte patch", len);
+
+	return 0;
+}
+
+static int upload_finish(void)
+{
+	int err;
+
+	err = flash_img_buffered_write(&upload.flash, NULL, 0, true);
+	if (!err) {
+		err = delta_finish(&upload.patch);
+	} else {
+		delta_abort(&upload.patch);
+	}
+
+	LOG_INF("Upload done, error %d: %u bytes from %u in %lld ms", err,
+		upload.patch.written, upload.len, k_uptime_get() - upload.start);
+
+	return err;
+}
+
+static int delta_img_mgmt_upload(struct smp_streamer *ctxt)
+{
+	zcbor_state_t *zse = ctxt->writer->zs;
+	zcbor_state_t *zsd = ctxt->reader->zs;
+	struct zcbor_string data = { 0 };
+	uint32_t off = UINT32_MAX;
+	uint32_t len = 0;
+	size_t decoded;
+	bool done = false;
+	bool ok;
+	int err;
+
+	struct zcbor_map_decode_key_val upload_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_uint32_decode, &off),
+		ZCBOR_MAP_DECODE_KEY_DECODER("len", zcbor_uint32_decode, &len),
+		ZCBOR_MAP_DECODE_KEY_DECODER("data", zcbor_bstr_decode, &data),
+	};
+
+	if (zcbor_map_decode_bulk(zsd, upload_decode, ARRAY_SIZE(upload_decode), &decoded) != 0 ||
+	    off == UINT32_MAX) {
+		return MGMT_ERR_EINVAL;
+	}
+
+	if (off == 0) {
+		if (len == 0 || upload_start(len) != 0) {
+			upload_abort();
+			return (len == 0) ? MGMT_ERR_EINVAL : MGMT_ERR_EUNKNOWN;
+		}
+	} else if (!upload.active) {
+		return MGMT_ERR_EBADSTATE;
+	}
+
+	/* Anything but the next chunk gets the expected offset back, as for image uploads */
+	if (off == upload.off && data.len > 0) {
+		if (data.len > upload.len - upload.off) {
+			upload_abort();
+			return MGMT_ERR_EINVAL;
+		}
+
+		err = delta_feed(&upload.patch, data.value, data.len);
+		upload.off += data.len;
+
+		if (!err && upload.off == upload.len) {
+			err = upload_finish();
+			upload.active = false;
+			done = true;
+		}
+
+		if (err) {
+			upload_abort();
+			return (err == -EINVAL || err == -EBADMSG) ? MGMT_ERR_EINVAL :
+								      MGMT_ERR_EUNKNOWN;
+		}
+	}
+
+	ok = zcbor_tstr_put_lit(zse, "off") && zcbor_uint32_put(zse, upload.off);
+	if (done) {
+		ok = ok && zcbor_tstr_put_lit(zse, "size") &&
+		     zcbor_uint32_put(zse, upload.patch.written) &&
+		     zcbor_tstr_put_lit(zse, "ms") &&
+		     zcbor_uint32_put(zse, (uint32_t)(k_uptime_get() - upload.start));
+	}
+
+	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+}
+
+static const struct mgmt_handler delta_img_mgmt_handlers[] = {
+	[DELTA_IMG_MGMT_ID_UPLOAD] = {
+		.mh_read = NULL,
+		.mh_write = delta_img_mgmt_upload,
+	},
+};
+
+static struct mgmt_group delta_img_mgmt_group = {
+	.mg_handlers = delta_img_mgmt_handlers,
+	.mg_handlers_count = ARRAY_SIZE(delta_img_mgmt_handlers),
+	.mg_group_id = DELTA_IMG_MGMT_GROUP_ID,
+};
+
+static void delta_img_mgmt_register_group(void)
+{
+	mgmt_register_group(&delta_img_mgmt_group);
+}
+
+MCUMGR_HANDLER_DEFINE(delta_img_mgmt, delta_img_mgmt_register_group);
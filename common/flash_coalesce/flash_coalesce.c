@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Flash driver gathering writes into page programs of another flash.
+ *
+ * Writes are copied into page buffers and return. A page is queued once the
+ * writes reach its end, or are not contiguous with it anymore, and the driver
+ * thread programs the queue in order. Reads and erases outside the region
+ * erased ahead wait for the queue to be programmed first.
+ *
+ * In the region erased ahead, the thread erases the next sector whenever the
+ * queue is empty, up to CONFIG_DEVACADEMY_FLASH_COALESCE_ERASE_AHEAD sectors
+ * past the last write, and before programming a page of a sector not erased
+ * yet. An erase request for sectors of the region not written yet only waits
+ * for the thread to get there.
+ */
+
+#define DT_DRV_COMPAT devacademy_flash_coalesce
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+#include <devacademy/flash_coalesce.h>
+
+LOG_MODULE_REGISTER(flash_coalesce, CONFIG_DEVACADEMY_FLASH_COALESCE_LOG_LEVEL);
+
+#define PROG_SIZE   CONFIG_DEVACADEMY_FLASH_COALESCE_PAGE_SIZE
+#define PAGE_COUNT  CONFIG_DEVACADEMY_FLASH_COALESCE_PAGES
+#define ERASE_AHEAD CONFIG_DEVACADEMY_FLASH_COALESCE_ERASE_AHEAD
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PROG_SIZE), "Page size must be a power of two");
+
+struct page {
+	sys_snode_t node;
+	off_t offset;
+	size_t len;
+	uint8_t data[PROG_SIZE];
+};
+
+struct flash_coalesce_config {
+	const struct device *flash;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+};
+
+struct flash_coalesce_data {
+	struct flash_parameters params;
+	size_t size;
+
+	struct k_mutex lock;
+	/* Broadcast on every change of the state below */
+	struct k_condvar changed;
+
+	struct page pages[PAGE_COUNT];
+	sys_slist_t free;
+	sys_slist_t queue;
+	/* Page being filled by writes */
+	struct page *cur;
+	/* Pages queued or being programmed */
+	uint32_t in_flight;
+	/* Error of the thread, returned by the next write, erase or flush */
+	int err;
+
+	/* Region erased ahead, erased from ahead_start to erased */
+	off_t ahead_start;
+	off_t ahead_end;
+	off_t erased;
+	/* End of the writes into the region, and of the erase a caller waits for */
+	off_t write_end;
+	off_t erase_wanted;
+	size_t sector_size;
+
+	struct flash_coalesce_stats stats;
+	struct k_thread thread;
+};
+
+enum op {
+	OP_NONE,
+	OP_PROGRAM,
+	OP_ERASE,
+};
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+/* Wait for a change with the lock held, counted as a stall of the caller */
+static void stall(struct flash_coalesce_data *data)
+{
+	uint32_t start = k_cycle_get_32();
+
+	k_condvar_wait(&data->changed, &data->lock, K_FOREVER);
+	data->stats.stall_us += elapsed_us(start);
+}
+
+static bool in_region(struct flash_coalesce_data *data, off_t offset)
+{
+	return offset >= data->ahead_start && offset < data->ahead_end;
+}
+
+static bool range_valid(struct flash_coalesce_data *data, off_t offset, size_t len)
+{
+	return offset >= 0 && (size_t)offset <= data->size && len <= data->size - offset;
+}
+
+static int err_take(struct flash_coalesce_data *data)
+{
+	int err = data->err;
+
+	data->err = 0;
+
+	return err;
+}
+
+static void page_queue(struct flash_coalesce_data *data)
+{
+	if (data->cur == NULL) {
+		return;
+	}
+
+	sys_slist_append(&data->queue, &data->cur->node);
+	data->cur = NULL;
+	data->in_flight++;
+	k_condvar_broadcast(&data->changed);
+}
+
+/* Queue the page being filled and wait until all are programmed */
+static void programs_wait(struct flash_coalesce_data *data)
+{
+	page_queue(data);
+
+	while (data->in_flight > 0) {
+		stall(data);
+	}
+}
+
+static enum op op_next(struct flash_coalesce_data *data, struct page **page)
+{
+	*page = SYS_SLIST_PEEK_HEAD_CONTAINER(&data->queue, *page, node);
+
+	if (*page != NULL) {
+		if (in_region(data, (*page)->offset) &&
+		    (*page)->offset + (off_t)(*page)->len > data->erased) {
+			return OP_ERASE;
+		}
+
+		return OP_PROGRAM;
+	}
+
+	if (data->erased < data->ahead_end &&
+	    (data->erased < data->write_end + (off_t)(ERASE_AHEAD * data->sector_size) ||
+	     data->erased < data->erase_wanted)) {
+		return OP_ERASE;
+	}
+
+	return OP_NONE;
+}
+
+static void flash_coalesce_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev = p1;
+	const struct flash_coalesce_config *config = dev->config;
+	struct flash_coalesce_data *data = dev->data;
+	struct flash_pages_info info = { 0 };
+	struct page *page;
+	enum op op;
+	off_t offset;
+	uint32_t start;
+	uint32_t us;
+	int err;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	for (;;) {
+		op = op_next(data, &page);
+
+		if (op == OP_NONE) {
+			/* A page left partial is programmed as it is, with nothing
+			 * pending the thread sleeps until the next change
+			 */
+			if (k_condvar_wait(&data->changed, &data->lock,
+					   (data->cur != NULL) ?
+					   K_MSEC(CONFIG_DEVACADEMY_FLASH_COALESCE_FLUSH_MS) :
+					   K_FOREVER) == -EAGAIN) {
+				page_queue(data);
+			}
+			continue;
+		}
+
+		offset = (op == OP_PROGRAM) ? page->offset : data->erased;
+		k_mutex_unlock(&data->lock);
+
+		start = k_cycle_get_32();
+
+		if (op == OP_PROGRAM) {
+			err = flash_write(config->flash, offset, page->data, page->len);
+		} else {
+			err = flash_get_page_info_by_offs(config->flash, offset, &info);
+			if (!err) {
+				err = flash_erase(config->flash, info.start_offset, info.size);
+			}
+		}
+
+		us = elapsed_us(start);
+
+		k_mutex_lock(&data->lock, K_FOREVER);
+
+		if (op == OP_PROGRAM) {
+			sys_slist_get(&data->queue);
+			sys_slist_append(&data->free, &page->node);
+			data->in_flight--;
+			data->stats.programs++;
+			data->stats.program_us += us;
+		} else {
+			data->stats.erases++;
+			data->stats.erase_us += us;
+
+			if (err) {
+				/* Pages of the region are programmed without erase from now */
+				data->ahead_end = data->erased;
+			} else if (data->erased == offset) {
+				data->erased = info.start_offset + info.size;
+			}
+		}
+
+		if (err) {
+			LOG_ERR("%s at 0x%lx, error: %d", (op == OP_PROGRAM) ? "Program" : "Erase",
+				(long)offset, err);
+			data->err = err;
+		}
+
+		k_condvar_broadcast(&data->changed);
+	}
+}
+
+static int flash_coalesce_read(const struct device *dev, off_t offset, void *buf, size_t len)
+{
+	const struct flash_coalesce_config *config = dev->config;
+	struct flash_coalesce_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	programs_wait(data);
+	k_mutex_unlock(&data->lock);
+
+	return flash_read(config->flash, offset, buf, len);
+}
+
+static int flash_coalesce_write(const struct device *dev, off_t offset, const void *buf,
+				size_t len)
+{
+	struct flash_coalesce_data *data = dev->data;
+	const uint8_t *src = buf;
+	off_t page_end;
+	size_t n;
+	int err;
+
+	if (!range_valid(data, offset, len)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	err = err_take(data);
+
+	while (len > 0 && !err) {
+		if (data->cur != NULL && data->cur->offset + (off_t)data->cur->len != offset) {
+			page_queue(data);
+		}
+
+		if (data->cur == NULL) {
+			while (sys_slist_is_empty(&data->free)) {
+				stall(data);
+			}
+
+			data->cur = CONTAINER_OF(sys_slist_get(&data->free), struct page, node);
+			data->cur->offset = offset;
+			data->cur->len = 0;
+			/* Starts the flush timeout of the thread */
+			k_condvar_broadcast(&data->changed);
+		}
+
+		page_end = ROUND_DOWN(offset, PROG_SIZE) + PROG_SIZE;
+		n = MIN(len, (size_t)(page_end - offset));
+
+		memcpy(&data->cur->data[data->cur->len], src, n);
+		data->cur->len += n;
+		offset += n;
+		src += n;
+		len -= n;
+
+		if (in_region(data, offset - 1) && offset > data->write_end) {
+			data->write_end = offset;
+			/* The erase ahead moves on with it */
+			k_condvar_broadcast(&data->changed);
+		}
+
+		if (offset == page_end) {
+			page_queue(data);
+		}
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	return err;
+}
+
+static int flash_coalesce_erase(const struct device *dev, off_t offset, size_t size)
+{
+	const struct flash_coalesce_config *config = dev->config;
+	struct flash_coalesce_data *data = dev->data;
+	off_t end = offset + (off_t)size;
+	uint32_t start;
+	uint32_t us;
+	int err;
+
+	if (!range_valid(data, offset, size)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	/* Sectors of the region not written since they were erased ahead */
+	if (size > 0 && in_region(data, offset) && offset >= data->write_end &&
+	    end <= data->ahead_end) {
+		data->erase_wanted = MAX(data->erase_wanted, end);
+		k_condvar_broadcast(&data->changed);
+
+		while (in_region(data, offset) && data->erased < end) {
+			stall(data);
+		}
+
+		if (data->erased >= end) {
+			data->stats.erases_ahead++;
+			k_mutex_unlock(&data->lock);
+			return 0;
+		}
+	}
+
+	/* Erasing what was written in the region, stop erasing ahead */
+	if (offset < data->ahead_end && end > data->ahead_start) {
+		data->ahead_start = 0;
+		data->ahead_end = 0;
+		data->erased = 0;
+		data->write_end = 0;
+		data->erase_wanted = 0;
+	}
+
+	programs_wait(data);
+	err = err_take(data);
+	k_mutex_unlock(&data->lock);
+
+	if (err) {
+		return err;
+	}
+
+	start = k_cycle_get_32();
+	err = flash_erase(config->flash, offset, size);
+	us = elapsed_us(start);
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	data->stats.erases++;
+	data->stats.erase_us += us;
+	data->stats.stall_us += us;
+	k_mutex_unlock(&data->lock);
+
+	return err;
+}
+
+static const struct flash_parameters *flash_coalesce_get_parameters(const struct device *dev)
+{
+	struct flash_coalesce_data *data = dev->data;
+
+	return &data->params;
+}
+
+static void flash_coalesce_page_layout(const struct device *dev,
+				       const struct flash_pages_layout **layout,
+				       size_t *layout_size)
+{
+	const struct flash_coalesce_config *config = dev->config;
+
+	DEVICE_API_GET(flash, config->flash)->page_layout(config->flash, layout, layout_size);
+}
+
+static DEVICE_API(flash, flash_coalesce_api) = {
+	.read = flash_coalesce_read,
+	.write = flash_coalesce_write,
+	.erase = flash_coalesce_erase,
+	.get_parameters = flash_coalesce_get_parameters,
+	.page_layout = flash_coalesce_page_layout,
+};
+
+int flash_coalesce_erase_ahead(const struct device *dev, off_t offset, size_t size)
+{
+	const struct flash_coalesce_config *config;
+	struct flash_coalesce_data *data;
+	struct flash_pages_info first;
+	struct flash_pages_info last;
+	int err;
+
+	if (dev->api != &flash_coalesce_api) {
+		return -ENODEV;
+	}
+
+	config = dev->config;
+	data = dev->data;
+
+	if (size == 0 || !range_valid(data, offset, size)) {
+		return -EINVAL;
+	}
+
+	err = flash_get_page_info_by_offs(config->flash, offset, &first);
+	if (!err) {
+		err = flash_get_page_info_by_offs(config->flash, offset + size - 1, &last);
+	}
+	if (err) {
+		return err;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	/* Writes made before belong to the previous contents */
+	programs_wait(data);
+
+	data->ahead_start = first.start_offset;
+	data->ahead_end = last.start_offset + last.size;
+	data->erased = data->ahead_start;
+	data->write_end = data->ahead_start;
+	data->erase_wanted = data->ahead_start;
+	data->sector_size = first.size;
+	k_condvar_broadcast(&data->changed);
+
+	k_mutex_unlock(&data->lock);
+
+	LOG_INF("%s: erasing 0x%lx-0x%lx ahead", dev->name, (long)data->ahead_start,
+		(long)data->ahead_end);
+
+	return 0;
+}
+
+int flash_coalesce_flush(const struct device *dev)
+{
+	struct flash_coalesce_data *data = dev->data;
+	int err;
+
+	if (dev->api != &flash_coalesce_api) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	programs_wait(data);
+	err = err_take(data);
+	k_mutex_unlock(&data->lock);
+
+	return err;
+}
+
+void flash_coalesce_stats_get(const struct device *dev, struct flash_coalesce_stats *stats)
+{
+	struct flash_coalesce_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	*stats = data->stats;
+	memset(&data->stats, 0, sizeof(data->stats));
+	k_mutex_unlock(&data->lock);
+}
+
+static int flash_coalesce_init(const struct device *dev)
+{
+	const struct flash_coalesce_config *config = dev->config;
+	struct flash_coalesce_data *data = dev->data;
+	struct flash_pages_info info;
+	int err;
+
+	if (!device_is_ready(config->flash)) {
+		LOG_ERR("%s not ready", config->flash->name);
+		return -ENODEV;
+	}
+
+	data->params = *flash_get_parameters(config->flash);
+	if (PROG_SIZE % data->params.write_block_size != 0) {
+		LOG_ERR("Write block of %s not a divider of the page", config->flash->name);
+		return -EINVAL;
+	}
+
+	err = flash_get_page_info_by_idx(config->flash, flash_get_page_count(config->flash) - 1,
+					 &info);
+	if (err) {
+		return err;
+	}
+
+	data->size = info.start_offset + info.size;
+
+	k_mutex_init(&data->lock);
+	k_condvar_init(&data->changed);
+	sys_slist_init(&data->free);
+	sys_slist_init(&data->queue);
+
+	for (size_t i = 0; i < ARRAY_SIZE(data->pages); i++) {
+		sys_slist_append(&data->free, &data->pages[i].node);
+	}
+
+	k_thread_create(&data->thread, config->stack, config->stack_size, flash_coalesce_thread,
+			(void *)dev, NULL, NULL,
+			K_PRIO_PREEMPT(CONFIG_DEVACADEMY_FLASH_COALESCE_THREAD_PRIORITY), 0,
+			K_NO_WAIT);
+	k_thread_name_set(&data->thread, dev->name);
+
+	return 0;
+}
+
+#define FLASH_COALESCE_DEFINE(n)                                                                   \
+	static K_KERNEL_STACK_DEFINE(flash_coalesce_stack_##n,                                     \
+				     CONFIG_DEVACADEMY_FLASH_COALESCE_STACK_SIZE);                 \
+                                                                                                   \
+	static struct flash_coalesce_data flash_coalesce_data_##n;                                 \
+                                                                                                   \
+	static const struct flash_coalesce_config flash_coalesce_config_##n = {                    \
+		.flash = DEVICE_DT_GET(DT_INST_PHANDLE(n, flash)),                                 \
+		.stack = flash_coalesce_stack_##n,                                                 \
+		.stack_size = K_KERNEL_STACK_SIZEOF(flash_coalesce_stack_##n),                     \
+	};                                                                                         \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(n, flash_coalesce_init, NULL, &flash_coalesce_data_##n,              \
+			      &flash_coalesce_config_##n, POST_KERNEL,                             \
+			      CONFIG_DEVACADEMY_FLASH_COALESCE_INIT_PRIORITY, &flash_coalesce_api);
+
+DT_INST_FOREACH_STATUS_OKAY(FLASH_COALESCE_DEFINE)
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Erase the secondary slot ahead of image uploads.
+ *
+ * With IMG_ERASE_PROGRESSIVELY, the image management group erases each
+ * sector of the slot just before writing into it, and the upload waits for
+ * the erase. Announcing the image to the devacademy,flash-coalesce device of
+ * the slot on the first chunk has it erased in the background instead.
+ *
+ * The device buffers the writes, the slot is flushed once the upload is
+ * complete, after the image is marked for test or confirmed and before an
+ * mcumgr reset, so that MCUboot finds the whole image and its trailer.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/init.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+#include <zephyr/mgmt/mcumgr/grp/os_mgmt/os_mgmt.h>
+#endif
+#include <devacademy/flash_coalesce.h>
+
+LOG_MODULE_REGISTER(flash_coalesce_dfu, CONFIG_DEVACADEMY_FLASH_COALESCE_LOG_LEVEL);
+
+static enum mgmt_cb_return upload_cb(uint32_t event, enum mgmt_cb_return prev_status,
+				     int32_t *rc, uint16_t *group, bool *abort_more, void *data,
+				     size_t data_size)
+{
+	const struct img_mgmt_upload_check *check = data;
+	const struct flash_area *fa;
+	int err;
+
+	if (check->req->off != 0 || check->req->image != 0) {
+		return MGMT_CB_OK;
+	}
+
+	err = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	if (err) {
+		LOG_ERR("flash_area_open, error: %d", err);
+		return MGMT_CB_OK;
+	}
+
+	err = flash_coalesce_erase_ahead(flash_area_get_device(fa), fa->fa_off,
+					 MIN(check->req->size, fa->fa_size));
+	if (err && err != -ENODEV) {
+		LOG_ERR("flash_coalesce_erase_ahead, error: %d", err);
+	}
+
+	flash_area_close(fa);
+
+	/* The upload goes on as without */
+	return MGMT_CB_OK;
+}
+
+/* Program what the device of the slot still buffers */
+static enum mgmt_cb_return flush_cb(uint32_t event, enum mgmt_cb_return prev_status,
+				    int32_t *rc, uint16_t *group, bool *abort_more, void *data,
+				    size_t data_size)
+{
+	const struct flash_area *fa;
+	int err;
+
+	err = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	if (err) {
+		LOG_ERR("flash_area_open, error: %d", err);
+		return MGMT_CB_OK;
+	}
+
+	err = flash_coalesce_flush(flash_area_get_device(fa));
+	if (err && err != -ENODEV) {
+		LOG_ERR("flash_coalesce_flush, error: %d", err);
+	}
+
+	flash_area_close(fa);
+
+	return MGMT_CB_OK;
+}
+
+static struct mgmt_callback upload_callback = {
+	.callback = upload_cb,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK,
+};
+
+/* Upload complete, image marked for test or confirmed */
+static struct mgmt_callback image_callback = {
+	.callback = flush_cb,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_DFU_PENDING | MGMT_EVT_OP_IMG_MGMT_DFU_CONFIRMED,
+};
+
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+static struct mgmt_callback reset_callback = {
+	.callback = flush_cb,
+	.event_id = MGMT_EVT_OP_OS_MGMT_RESET,
+};
+#endif
+
+static int flash_coalesce_dfu_init(void)
+{
+	mgmt_callback_register(&upload_callback);
+	mgmt_callback_register(&image_callback);
+#if defined(CONFIG_MCUMGR_GRP_OS_RESET_HOOK)
+	mgmt_callback_register(&reset_callback);
+#endif
+
+	return 0;
+}
+
+SYS_INIT(flash_coalesce_dfu_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
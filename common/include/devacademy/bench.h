@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_BENCH_H_
+#define DEVACADEMY_BENCH_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/iterable_sections.h>
+
+/* A benchmarked function. It is called with @p arg and returns a value that is
+ * folded into a checksum, so that the compiler cannot optimize the work away and
+ * so that the results of different builds can be compared.
+ */
+struct bench_kernel {
+	const char *name;
+	uint32_t (*fn)(uint32_t arg);
+	uint32_t arg;
+};
+
+/* @brief Register a kernel with the benchmark harness.
+ *
+ * @param _name Name of the kernel, used in the summary.
+ * @param _fn   Function to benchmark, uint32_t (*)(uint32_t).
+ * @param _arg  Argument passed to the function.
+ */
+#define BENCH_KERNEL_DEFINE(_name, _fn, _arg)                                                      \
+	static const STRUCT_SECTION_ITERABLE(bench_kernel, _CONCAT(bench_kernel_, _name)) = {      \
+		.name = STRINGIFY(_name),                                                          \
+		.fn = _fn,                                                                         \
+		.arg = _arg,                                                                       \
+	}
+
+/* Statistics of a set of measurements, in clock cycles. */
+struct bench_stats {
+	uint64_t min;
+	uint64_t median;
+	uint64_t p99;
+	uint64_t max;
+	uint64_t mean;
+};
+
+/* @brief Compute the statistics of a set of measurements.
+ *
+ * Percentiles use the nearest-rank method.
+ *
+ * @param[in,out] samples Measurements, sorted in place.
+ * @param[in]     count   Number of measurements, at least 1.
+ * @param[out]    stats   Statistics.
+ */
+void bench_stats_compute(uint64_t *samples, size_t count, struct bench_stats *stats);
+
+/* @brief Convert clock cycles of the selected benchmark clock to nanoseconds. */
+uint64_t bench_cycles_to_ns(uint64_t cycles);
+
+/* @brief Run all registered kernels and print the summary.
+ *
+ * @return 0 on success, -ENOMEM if more than CONFIG_DEVACADEMY_BENCH_MAX_KERNELS are registered.
+ */
+int bench_run_all(void);
+
+/* @brief Get the statistics of a kernel measured by the last bench_run_all().
+ *
+ * @param[in] name Name of the kernel, as given to BENCH_KERNEL_DEFINE().
+ *
+ * @return Statistics, NULL if no kernel with this name was run.
+ */
+const struct bench_stats *bench_result_get(const char *name);
+
+#endif /* DEVACADEMY_BENCH_H_ */
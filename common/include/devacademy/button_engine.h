@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_BUTTON_ENGINE_H_
+#define DEVACADEMY_BUTTON_ENGINE_H_
+
+#include <zephyr/kernel.h>
+
+enum button_event_type {
+	/* A button was pressed, after debouncing. */
+	BUTTON_EVT_PRESS,
+	/* A button was released, after debouncing. */
+	BUTTON_EVT_RELEASE,
+	/* A button has been held for CONFIG_DEVACADEMY_BUTTON_ENGINE_LONG_PRESS_MS. */
+	BUTTON_EVT_LONG_PRESS,
+	/* A button is still held, every CONFIG_DEVACADEMY_BUTTON_ENGINE_REPEAT_MS after a long press. */
+	BUTTON_EVT_REPEAT,
+	/* Several buttons were pressed within CONFIG_DEVACADEMY_BUTTON_ENGINE_CHORD_WINDOW_MS. */
+	BUTTON_EVT_CHORD,
+};
+
+struct button_event {
+	/* Uptime in milliseconds of the button edge, or of the timer for long press,
+	 * repeat and chord events.
+	 */
+	int64_t timestamp;
+	/* Bit mask of the buttons the event is about. */
+	uint32_t buttons;
+	/* Bit mask of the buttons held after the event. */
+	uint32_t state;
+	/* One of enum button_event_type. */
+	uint8_t type;
+};
+
+/* @brief Get a batch of button events.
+ *
+ * Waits for the first event, then returns it together with the events already queued
+ * behind it, so that the caller can act once on the result of a whole burst.
+ *
+ * @param[out] events  Array the events are copied to, oldest first.
+ * @param[in]  max     Size of the array.
+ * @param[in]  timeout Time to wait for the first event.
+ *
+ * @return Number of events, 0 if none arrived within the timeout.
+ */
+size_t button_engine_batch_get(struct button_event *events, size_t max, k_timeout_t timeout);
+
+/* @brief Get the debounced state of the buttons.
+ *
+ * @return Bit mask of the buttons currently held.
+ */
+uint32_t button_engine_state_get(void);
+
+/* @brief Get the number of events dropped because a queue was full.
+ *
+ * @return Number of dropped input and button events since boot.
+ */
+uint32_t button_engine_dropped_get(void);
+
+#endif /* DEVACADEMY_BUTTON_ENGINE_H_ */
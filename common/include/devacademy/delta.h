@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_DELTA_H_
+#define DEVACADEMY_DELTA_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <psa/crypto.h>
+
+/* Patch made by scripts/delta_diff.py, all numbers little endian:
+ *
+ *   "DLT1", u32 old size, old SHA-256, u32 new size, new SHA-256
+ *   commands, each starting with an opcode byte:
+ *     0x00 end
+ *     0x01 copy:   varint zigzag(offset - end of the previous copy), varint length
+ *                  bytes of the current image at offset
+ *     0x02 insert: varint length, then length bytes of the new image
+ *
+ * Varints are LEB128 of at most 32 bits.
+ */
+#define DELTA_MAGIC	   "DLT1"
+#define DELTA_HDR_SIZE	   (4 + 4 + 32 + 4 + 32)
+
+/* @brief Read len bytes of the current image at offset.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+typedef int (*delta_read_t)(void *user, uint32_t offset, uint8_t *buf, size_t len);
+
+/* @brief Write the next len bytes of the new image.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+typedef int (*delta_write_t)(void *user, const uint8_t *data, size_t len);
+
+/* Patch being applied, the only memory the applier uses. */
+struct delta_ctx {
+	delta_read_t read_old;
+	delta_write_t write_new;
+	void *user;
+
+	uint8_t hdr[DELTA_HDR_SIZE];
+	size_t hdr_len;
+	uint32_t old_size;
+	uint32_t new_size;
+
+	uint8_t state;
+	uint8_t varint_shift;
+	uint32_t varint;
+	uint32_t copy_offset;
+	/* End of the previous copy, copy offsets are relative to it */
+	uint32_t copy_end;
+	/* Bytes left in the insert command */
+	uint32_t insert_left;
+
+	/* Bytes of the new image written, copied from the current one and inserted */
+	uint32_t written;
+	uint32_t copied;
+	uint32_t inserted;
+
+	psa_hash_operation_t hash;
+	uint8_t buf[CONFIG_DEVACADEMY_DELTA_COPY_BUF_SIZE];
+};
+
+/* @brief Check if a download starts with the patch magic. */
+bool delta_is_patch(const uint8_t *data, size_t len);
+
+/* @brief Prepare to apply a patch.
+ *
+ * @param[in] read_old Reads the image the patch was made against.
+ * @param[in] write_new Writes the new image in order.
+ */
+int delta_init(struct delta_ctx *ctx, delta_read_t read_old, delta_write_t write_new,
+	       void *user);
+
+/* @brief Apply the next bytes of the patch, in pieces of any size.
+ *
+ * The hash of the current image is checked once the header is in, before
+ * anything is written.
+ *
+ * @return 0 on success, -EINVAL if the patch is malformed or made against
+ *	   another image, or the error of a callback.
+ */
+int delta_feed(struct delta_ctx *ctx, const uint8_t *data, size_t len);
+
+/* @brief Check that the whole patch was applied and the new image hash.
+ *
+ * @return 0 on success, -EBADMSG if the patch is incomplete or the hash differs.
+ */
+int delta_finish(struct delta_ctx *ctx);
+
+/* @brief Release the hash operation of a patch that will not be finished. */
+void delta_abort(struct delta_ctx *ctx);
+
+#endif /* DEVACADEMY_DELTA_H_ */
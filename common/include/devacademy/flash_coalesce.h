@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_FLASH_COALESCE_H_
+#define DEVACADEMY_FLASH_COALESCE_H_
+
+#include <sys/types.h>
+#include <zephyr/device.h>
+#include <zephyr/types.h>
+
+/* Work done by a devacademy,flash-coalesce device, times in microseconds. */
+struct flash_coalesce_stats {
+	/* Page programs and sector erases of the flash */
+	uint32_t programs;
+	uint32_t erases;
+	/* Erase requests answered by the background erase */
+	uint32_t erases_ahead;
+	uint32_t program_us;
+	uint32_t erase_us;
+	/* Time callers waited for a page buffer, an erase or the programs in flight */
+	uint32_t stall_us;
+};
+
+/* @brief Erase a region in the background as it gets written.
+ *
+ * Sectors are erased in order from offset, at most
+ * CONFIG_DEVACADEMY_FLASH_COALESCE_ERASE_AHEAD past the last write into the
+ * region. Erase requests for the sectors not written yet then only wait for
+ * the background erase. The previous region is dropped.
+ *
+ * @return 0 on success, -ENODEV if dev is not a devacademy,flash-coalesce
+ *	   device, -EINVAL if the region is outside the flash.
+ */
+int flash_coalesce_erase_ahead(const struct device *dev, off_t offset, size_t size);
+
+/* @brief Program the buffered writes and wait until they are done.
+ *
+ * @return 0 on success, -ENODEV if dev is not a devacademy,flash-coalesce
+ *	   device, or the error of a program since the last call.
+ */
+int flash_coalesce_flush(const struct device *dev);
+
+/* @brief Get and clear the counters of a device. */
+void flash_coalesce_stats_get(const struct device *dev, struct flash_coalesce_stats *stats);
+
+#endif /* DEVACADEMY_FLASH_COALESCE_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_LZ4_STREAM_H_
+#define DEVACADEMY_LZ4_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+
+/* Image compressed by scripts/lz4_pack.py, all numbers little endian:
+ *
+ *   "DLZ4", u32 image size, u32 window size
+ *   one LZ4 block (lz4_Block_format.md) holding the whole image
+ *
+ * Matches start less than window size bytes back, the window size must not be
+ * more than CONFIG_DEVACADEMY_LZ4_WINDOW_SIZE.
+ */
+#define LZ4_STREAM_MAGIC    "DLZ4"
+#define LZ4_STREAM_HDR_SIZE (4 + 4 + 4)
+
+/* @brief Write the next len bytes of the image.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+typedef int (*lz4_stream_write_t)(void *user, const uint8_t *data, size_t len);
+
+/* Image being decompressed, the only memory the decoder uses. */
+struct lz4_stream_ctx {
+	lz4_stream_write_t write;
+	void *user;
+
+	uint8_t hdr[LZ4_STREAM_HDR_SIZE];
+	size_t hdr_len;
+	uint32_t size;
+
+	uint8_t state;
+	uint8_t token;
+	uint32_t literal_left;
+	uint32_t match_len;
+	uint16_t offset;
+
+	/* Compressed bytes in and image bytes out */
+	uint32_t consumed;
+	uint32_t written;
+
+	/* Last bytes of the image, written out each time it fills up */
+	uint8_t window[CONFIG_DEVACADEMY_LZ4_WINDOW_SIZE];
+};
+
+/* @brief Check if a download starts with the compressed image magic. */
+bool lz4_stream_is_compressed(const uint8_t *data, size_t len);
+
+/* @brief Prepare to decompress an image.
+ *
+ * @param[in] write Writes the image in order, in pieces of up to the window size.
+ */
+void lz4_stream_init(struct lz4_stream_ctx *ctx, lz4_stream_write_t write, void *user);
+
+/* @brief Decompress the next bytes, in pieces of any size.
+ *
+ * @return 0 on success, -EINVAL if the data is malformed or needs a larger
+ *	   window, or the error of the write callback.
+ */
+int lz4_stream_feed(struct lz4_stream_ctx *ctx, const uint8_t *data, size_t len);
+
+/* @brief Write out the end of the image and check that it is complete.
+ *
+ * @return 0 on success, -EBADMSG if the image is incomplete, or the error of
+ *	   the write callback.
+ */
+int lz4_stream_finish(struct lz4_stream_ctx *ctx);
+
+#endif /* DEVACADEMY_LZ4_STREAM_H_ */
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_OFFLOAD_H_
+#define DEVACADEMY_OFFLOAD_H_
+
+#include <zephyr/types.h>
+
+/* Messages exchanged over the "offload" IPC service endpoint between the
+ * application core (client) and the remote core (server). Both cores are
+ * little-endian, the structures are sent as they are.
+ */
+#define OFFLOAD_ENDPOINT_NAME "offload"
+
+enum offload_op {
+	OFFLOAD_OP_FIBONACCI = 1,
+	OFFLOAD_OP_COUNT_PRIMES = 2,
+	OFFLOAD_OP_COLLATZ = 3,
+	OFFLOAD_OP_PERFECT_NUMBERS = 4,
+};
+
+struct offload_request {
+	/* Chosen by the client, echoed in the response. */
+	uint32_t id;
+	/* One of enum offload_op. */
+	uint16_t op;
+	uint16_t reserved;
+	uint32_t arg;
+} __packed;
+
+struct offload_response {
+	uint32_t id;
+	/* 0 on success, -ENOTSUP for an unknown operation, -EBUSY if the server queue was full. */
+	int32_t status;
+	uint32_t result;
+	/* Time the server spent executing the request, in microseconds. */
+	uint32_t exec_us;
+} __packed;
+
+#endif /* DEVACADEMY_OFFLOAD_H_ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_PROF_H_
+#define DEVACADEMY_PROF_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/timing/timing.h>
+
+#if defined(CONFIG_DEVACADEMY_PROF)
+
+/* Statistics of a probe, in cycles of the selected clock. */
+struct prof_probe {
+	const char *name;
+	uint64_t sum;
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+};
+
+struct prof_scope {
+	struct prof_probe *probe;
+	uint32_t start;
+};
+
+static inline uint32_t prof_now(void)
+{
+#if defined(CONFIG_DEVACADEMY_PROF_CLOCK_TIMING)
+	return (uint32_t)timing_counter_get();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+/* @brief Add a measurement to a probe. Safe to call from interrupts. */
+void prof_probe_record(struct prof_probe *probe, uint32_t cycles);
+
+static inline void prof_scope_end(struct prof_scope *scope)
+{
+	prof_probe_record(scope->probe, prof_now() - scope->start);
+}
+
+/* @brief Time the rest of the enclosing scope.
+ *
+ * The measurement is taken when the scope is left, including through return
+ * or break. At most one probe per line.
+ *
+ * @param _name Name of the probe, a string literal.
+ */
+#define PROF_SCOPE(_name)                                                                          \
+	static STRUCT_SECTION_ITERABLE(prof_probe, _CONCAT(prof_probe_, __LINE__)) = {             \
+		.name = _name,                                                                     \
+		.min = UINT32_MAX,                                                                 \
+	};                                                                                         \
+	struct prof_scope _CONCAT(prof_scope_, __LINE__)                                          \
+		__attribute__((cleanup(prof_scope_end))) = {                                       \
+		.probe = &_CONCAT(prof_probe_, __LINE__),                                          \
+		.start = prof_now(),                                                               \
+	}
+
+/* @brief Print the statistics of all probes as CSV with printk. */
+void prof_report_print(void);
+
+/* @brief Clear the statistics of all probes. */
+void prof_reset(void);
+
+#else
+
+#define PROF_SCOPE(_name)
+
+static inline void prof_report_print(void)
+{
+}
+
+static inline void prof_reset(void)
+{
+}
+
+#endif /* CONFIG_DEVACADEMY_PROF */
+
+#endif /* DEVACADEMY_PROF_H_ */
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_REMOTE_CONSOLE_H_
+#define DEVACADEMY_REMOTE_CONSOLE_H_
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+/* Record written into the remote console ring for each log message, followed
+ * by the formatted message without its line ending and without terminator.
+ */
+struct remote_console_record {
+	/* Time of the message on the remote core, in microseconds. */
+	uint32_t timestamp_us;
+	/* Messages dropped by the remote core just before this one. */
+	uint16_t dropped;
+	/* Log level, 0 for printk output. */
+	uint8_t level;
+	uint8_t reserved;
+	/* Name of the remote core, not necessarily terminated. */
+	char source[8];
+} __packed;
+
+#endif /* DEVACADEMY_REMOTE_CONSOLE_H_ */
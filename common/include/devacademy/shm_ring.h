@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_SHM_RING_H_
+#define DEVACADEMY_SHM_RING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/types.h>
+
+struct shm_ring_ctrl;
+
+/* Single-producer single-consumer ring in memory shared between two cores.
+ *
+ * The ring memory starts with three control lines holding the ring
+ * description, the producer index and the consumer index. The rest is
+ * divided in lines of CONFIG_DEVACADEMY_SHM_RING_LINE_SIZE bytes; each
+ * record starts on a line with a 32-bit length followed by the payload.
+ *
+ * Records are accessed in place: the producer claims space, writes the
+ * payload and commits it, the consumer peeks at the oldest record and
+ * releases it once done. Each side keeps its own struct shm_ring.
+ */
+struct shm_ring {
+	struct shm_ring_ctrl *ctrl;
+	uint8_t *data;
+	uint32_t line_count;
+	/* Producer: index of the claimed record. Consumer: unused. */
+	uint32_t claim_index;
+	/* Lines used by the claimed or peeked record, including any wrap padding. */
+	uint32_t pending_lines;
+};
+
+/* @brief Initialize a ring as its producer.
+ *
+ * Resets the ring, then marks it valid for the consumer.
+ *
+ * @param[out] ring Ring handle.
+ * @param[in]  mem  Shared memory, aligned to CONFIG_DEVACADEMY_SHM_RING_LINE_SIZE.
+ * @param[in]  size Size of the shared memory.
+ *
+ * @return 0 on success, -EINVAL if the memory is misaligned or too small.
+ */
+int shm_ring_producer_init(struct shm_ring *ring, void *mem, size_t size);
+
+/* @brief Attach to a ring as its consumer.
+ *
+ * @param[out] ring Ring handle.
+ * @param[in]  mem  Shared memory, as given to the producer.
+ * @param[in]  size Size of the shared memory.
+ *
+ * @return 0 on success, -EAGAIN if the producer has not initialized the ring yet.
+ */
+int shm_ring_consumer_init(struct shm_ring *ring, void *mem, size_t size);
+
+/* @brief Largest payload a ring can hold. */
+size_t shm_ring_max_payload(const struct shm_ring *ring);
+
+/* @brief Claim space for a record.
+ *
+ * @param[in] ring Ring handle.
+ * @param[in] len  Payload size.
+ *
+ * @return Pointer to the payload area, NULL if the ring is too full.
+ */
+void *shm_ring_claim(struct shm_ring *ring, size_t len);
+
+/* @brief Publish the claimed record.
+ *
+ * @param[in] ring Ring handle.
+ * @param[in] len  Payload size, at most the claimed size. Lines claimed past
+ *                 it are left free for the next record.
+ *
+ * @return true if the ring was empty, in which case the consumer must be notified.
+ */
+bool shm_ring_commit(struct shm_ring *ring, size_t len);
+
+/* @brief Get the oldest record.
+ *
+ * @param[in]  ring Ring handle.
+ * @param[out] len  Payload size.
+ *
+ * @return Pointer to the payload, NULL if the ring is empty.
+ */
+const void *shm_ring_peek(struct shm_ring *ring, size_t *len);
+
+/* @brief Release the record returned by shm_ring_peek(). */
+void shm_ring_release(struct shm_ring *ring);
+
+#endif /* DEVACADEMY_SHM_RING_H_ */
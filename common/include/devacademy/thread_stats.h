@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_THREAD_STATS_H_
+#define DEVACADEMY_THREAD_STATS_H_
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+/* Binary record layout, all fields little-endian:
+ *
+ *   struct thread_stats_hdr
+ *   struct thread_stats_thread[thread_count]
+ *   struct thread_stats_queue[queue_count]
+ *
+ * Loads are in permille of the sampling period.
+ */
+#define THREAD_STATS_VERSION  1
+#define THREAD_STATS_NAME_LEN 8
+
+struct thread_stats_hdr {
+	uint8_t version;
+	uint8_t thread_count;
+	uint8_t queue_count;
+	uint8_t reserved;
+	uint32_t uptime_ms;
+	uint16_t cpu_load;
+	uint16_t period_ms;
+} __packed;
+
+struct thread_stats_thread {
+	char name[THREAD_STATS_NAME_LEN];
+	int8_t priority;
+	uint8_t reserved;
+	uint16_t load;
+	uint16_t stack_size;
+	uint16_t stack_unused;
+} __packed;
+
+struct thread_stats_queue {
+	char name[THREAD_STATS_NAME_LEN];
+	uint16_t used;
+	uint16_t peak;
+	uint16_t capacity;
+	uint16_t reserved;
+} __packed;
+
+/* @brief Callback returning the number of items currently in a queue. */
+typedef uint32_t (*thread_stats_depth_cb)(void *user_data);
+
+#if defined(CONFIG_DEVACADEMY_THREAD_STATS)
+
+/* @brief Register a queue whose depth is reported in every record.
+ *
+ * @param[in] name      Name of the queue, truncated to THREAD_STATS_NAME_LEN characters.
+ * @param[in] depth     Callback returning the current depth.
+ * @param[in] capacity  Number of items the queue can hold, 0 if unbounded.
+ * @param[in] user_data Passed to the callback.
+ *
+ * @return 0 on success, -ENOMEM if CONFIG_DEVACADEMY_THREAD_STATS_MAX_QUEUES are registered.
+ */
+int thread_stats_queue_register(const char *name, thread_stats_depth_cb depth, uint32_t capacity,
+				void *user_data);
+
+/* @brief Register a message queue whose depth is reported in every record.
+ *
+ * @param[in] name  Name of the queue, truncated to THREAD_STATS_NAME_LEN characters.
+ * @param[in] msgq  Message queue.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int thread_stats_msgq_register(const char *name, struct k_msgq *msgq);
+
+/* @brief Copy the last record.
+ *
+ * @param[out] buf  Buffer the record is copied to.
+ * @param[in]  len  Size of the buffer.
+ *
+ * @return Size of the record, 0 if no record is available yet, -ENOMEM if the buffer is too small.
+ */
+int thread_stats_record_get(uint8_t *buf, size_t len);
+
+#else
+
+static inline int thread_stats_queue_register(const char *name, thread_stats_depth_cb depth,
+					      uint32_t capacity, void *user_data)
+{
+	return 0;
+}
+
+static inline int thread_stats_msgq_register(const char *name, struct k_msgq *msgq)
+{
+	return 0;
+}
+
+static inline int thread_stats_record_get(uint8_t *buf, size_t len)
+{
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_DEVACADEMY_THREAD_STATS */
+
+#endif /* DEVACADEMY_THREAD_STATS_H_ */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVACADEMY_TRACE_POINTS_H_
+#define DEVACADEMY_TRACE_POINTS_H_
+
+#include <zephyr/types.h>
+
+/* Pipeline stage trace points.
+ *
+ * A stage starts with TRACE_STAGE_BEGIN() and ends with TRACE_STAGE_END()
+ * called with the same stage name and sequence number, possibly from
+ * another thread or from an interrupt. Each point is emitted as a CTF named
+ * event with the sequence number in arg0 and the boundary in arg1, which
+ * lets scripts/trace_latency.py match the two ends of every item going
+ * through the stage.
+ *
+ * Stage names must be string literals of at most TRACE_STAGE_NAME_MAX
+ * characters, the length of a CTF named event name.
+ */
+#define TRACE_STAGE_NAME_MAX 19
+
+#define TRACE_STAGE_BOUNDARY_BEGIN 0
+#define TRACE_STAGE_BOUNDARY_END   1
+
+#if defined(CONFIG_DEVACADEMY_TRACE_POINTS)
+
+#include <zephyr/tracing/tracing.h>
+
+#define TRACE_STAGE_POINT(stage, seq, boundary)                                                    \
+	do {                                                                                       \
+		BUILD_ASSERT(sizeof(stage) - 1 <= TRACE_STAGE_NAME_MAX, "Stage name too long");     \
+		sys_trace_named_event(stage, (uint32_t)(seq), boundary);                          \
+	} while (0)
+
+#else
+
+#define TRACE_STAGE_POINT(stage, seq, boundary)                                                    \
+	do {                                                                                       \
+		ARG_UNUSED(seq);                                                                   \
+	} while (0)
+
+#endif /* CONFIG_DEVACADEMY_TRACE_POINTS */
+
+/* @brief Mark the start of a stage for item @p seq. */
+#define TRACE_STAGE_BEGIN(stage, seq) TRACE_STAGE_POINT(stage, seq, TRACE_STAGE_BOUNDARY_BEGIN)
+
+/* @brief Mark the end of a stage for item @p seq. */
+#define TRACE_STAGE_END(stage, seq) TRACE_STAGE_POINT(stage, seq, TRACE_STAGE_BOUNDARY_END)
+
+#endif /* DEVACADEMY_TRACE_POINTS_H_ */
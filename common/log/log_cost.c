@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/timing/timing.h>
+
+LOG_MODULE_REGISTER(log_cost, LOG_LEVEL_INF);
+
+/* Call shapes taken from the hot paths of the samples:
+ * - a constant string, like "Sensor Data acquired" in custom_bme280_sample_fetch()
+ * - a pointer and a counter, like the SAADC buffer report in saadc_event_handler()
+ * - three integers, like the AVG/MIN/MAX report in saadc_event_handler()
+ */
+enum log_cost_shape {
+	LOG_COST_SHAPE_STRING,
+	LOG_COST_SHAPE_PTR_INT,
+	LOG_COST_SHAPE_3_INT,
+	LOG_COST_SHAPE_COUNT,
+};
+
+static const char *const shape_names[LOG_COST_SHAPE_COUNT] = {
+	[LOG_COST_SHAPE_STRING] = "string",
+	[LOG_COST_SHAPE_PTR_INT] = "ptr+int",
+	[LOG_COST_SHAPE_3_INT] = "3 x int",
+};
+
+struct log_cost_result {
+	uint64_t min;
+	uint64_t max;
+	uint64_t sum;
+};
+
+static void log_call(enum log_cost_shape shape, uint32_t i)
+{
+	switch (shape) {
+	case LOG_COST_SHAPE_STRING:
+		LOG_INF("Sensor Data acquired");
+		break;
+	case LOG_COST_SHAPE_PTR_INT:
+		LOG_INF("SAADC buffer at %p filled with %d samples", (void *)&i, i);
+		break;
+	case LOG_COST_SHAPE_3_INT:
+		LOG_INF("AVG=%d, MIN=%d, MAX=%d", i, -(int32_t)i, 2 * i);
+		break;
+	default:
+		break;
+	}
+}
+
+/* In deferred mode, wait until the log thread has emptied the buffer so that
+ * every measured call allocates a message instead of hitting a full buffer.
+ */
+static void log_drain(void)
+{
+	while (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && log_data_pending()) {
+		k_sleep(K_MSEC(1));
+	}
+}
+
+static void log_cost_measure(enum log_cost_shape shape, struct log_cost_result *res)
+{
+	res->min = UINT64_MAX;
+	res->max = 0;
+	res->sum = 0;
+
+	for (uint32_t i = 0; i < CONFIG_DEVACADEMY_LOG_COST_ITERATIONS; i++) {
+		timing_t start, end;
+		uint64_t cycles;
+
+		log_drain();
+
+		start = timing_counter_get();
+		log_call(shape, i);
+		end = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &end);
+		res->min = MIN(res->min, cycles);
+		res->max = MAX(res->max, cycles);
+		res->sum += cycles;
+	}
+}
+
+static void log_cost_thread(void *unused1, void *unused2, void *unused3)
+{
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
+
+	struct log_cost_result results[LOG_COST_SHAPE_COUNT];
+
+	timing_init();
+	timing_start();
+
+	for (int shape = 0; shape < LOG_COST_SHAPE_COUNT; shape++) {
+		log_cost_measure(shape, &results[shape]);
+	}
+
+	timing_stop();
+	log_drain();
+
+	LOG_INF("Log call cost over %d calls (%s mode)", CONFIG_DEVACADEMY_LOG_COST_ITERATIONS,
+		IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) ? "deferred" : "immediate");
+
+	for (int shape = 0; shape < LOG_COST_SHAPE_COUNT; shape++) {
+		uint64_t avg = results[shape].sum / CONFIG_DEVACADEMY_LOG_COST_ITERATIONS;
+
+		LOG_INF("%-8s min %u avg %u max %u cycles (avg %u ns)", shape_names[shape],
+			(uint32_t)results[shape].min, (uint32_t)avg, (uint32_t)results[shape].max,
+			(uint32_t)timing_cycles_to_ns(avg));
+	}
+}
+
+K_THREAD_DEFINE(log_cost, 1024, log_cost_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, CONFIG_DEVACADEMY_LOG_COST_START_DELAY_MS);
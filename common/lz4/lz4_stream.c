@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Streaming LZ4 decoder, see devacademy/lz4_stream.h for the format.
+ *
+ * The sequences are parsed one byte at a time except for literals, which are
+ * copied from the input in pieces. The output goes through a ring window
+ * that matches copy from, and is written out each time the window fills up.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <devacademy/lz4_stream.h>
+
+LOG_MODULE_REGISTER(lz4_stream, CONFIG_DEVACADEMY_LZ4_LOG_LEVEL);
+
+#define WINDOW_SIZE	CONFIG_DEVACADEMY_LZ4_WINDOW_SIZE
+#define WINDOW_MASK	(WINDOW_SIZE - 1)
+
+#define MIN_MATCH	4
+#define LEN_EXTENDED	15
+
+BUILD_ASSERT(IS_POWER_OF_TWO(WINDOW_SIZE), "The window size must be a power of two");
+
+enum lz4_stream_state {
+	STATE_HEADER,
+	STATE_TOKEN,
+	STATE_LITERAL_LEN,
+	STATE_LITERALS,
+	STATE_OFFSET_LOW,
+	STATE_OFFSET_HIGH,
+	STATE_MATCH_LEN,
+	STATE_END,
+};
+
+/* The bytes were added at the head of the window */
+static int window_advance(struct lz4_stream_ctx *ctx, size_t len)
+{
+	ctx->written += len;
+
+	if ((ctx->written & WINDOW_MASK) == 0) {
+		return ctx->write(ctx->user, ctx->window, WINDOW_SIZE);
+	}
+
+	return 0;
+}
+
+static int output_check(struct lz4_stream_ctx *ctx, uint32_t len)
+{
+	if (len > ctx->size - ctx->written) {
+		LOG_ERR("Data past the end of the %u byte image", ctx->size);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int literals_put(struct lz4_stream_ctx *ctx, const uint8_t *data, size_t len)
+{
+	int err = 0;
+
+	while (len > 0 && !err) {
+		size_t head = ctx->written & WINDOW_MASK;
+		size_t piece = MIN(len, WINDOW_SIZE - head);
+
+		memcpy(&ctx->window[head], data, piece);
+		err = window_advance(ctx, piece);
+
+		data += piece;
+		len -= piece;
+	}
+
+	return err;
+}
+
+static int match_copy(struct lz4_stream_ctx *ctx)
+{
+	uint32_t len = ctx->match_len;
+	int err;
+
+	err = output_check(ctx, len);
+
+	while (len > 0 && !err) {
+		size_t head = ctx->written & WINDOW_MASK;
+		size_t src = (ctx->written - ctx->offset) & WINDOW_MASK;
+		/* At most offset bytes at a time, so that the source is all written
+		 * already. Past a wrap of the window the piece can still overlap the
+		 * source ahead of it, whose bytes are read before they are replaced.
+		 */
+		size_t piece = MIN(MIN(len, ctx->offset),
+				   MIN(WINDOW_SIZE - head, WINDOW_SIZE - src));
+
+		memmove(&ctx->window[head], &ctx->window[src], piece);
+		err = window_advance(ctx, piece);
+
+		len -= piece;
+	}
+
+	return err;
+}
+
+/* A sequence ends with its literals if they complete the image */
+static void literals_done(struct lz4_stream_ctx *ctx)
+{
+	ctx->state = (ctx->written == ctx->size) ? STATE_END : STATE_OFFSET_LOW;
+}
+
+static int match_start(struct lz4_stream_ctx *ctx)
+{
+	if (ctx->offset == 0 || ctx->offset > ctx->written || ctx->offset >= WINDOW_SIZE) {
+		LOG_ERR("Match %u bytes back at %u", ctx->offset, ctx->written);
+		return -EINVAL;
+	}
+
+	ctx->match_len = (ctx->token & 0x0f) + MIN_MATCH;
+	if ((ctx->token & 0x0f) == LEN_EXTENDED) {
+		ctx->state = STATE_MATCH_LEN;
+		return 0;
+	}
+
+	ctx->state = STATE_TOKEN;
+
+	return match_copy(ctx);
+}
+
+/* One byte of a sequence that is not a literal */
+static int sequence_put(struct lz4_stream_ctx *ctx, uint8_t byte)
+{
+	switch (ctx->state) {
+	case STATE_TOKEN:
+		ctx->token = byte;
+		ctx->literal_left = byte >> 4;
+		if (ctx->literal_left == LEN_EXTENDED) {
+			ctx->state = STATE_LITERAL_LEN;
+			return 0;
+		}
+		break;
+	case STATE_LITERAL_LEN:
+		ctx->literal_left += byte;
+		if (byte == 0xff) {
+			return 0;
+		}
+		break;
+	case STATE_OFFSET_LOW:
+		ctx->offset = byte;
+		ctx->state = STATE_OFFSET_HIGH;
+		return 0;
+	case STATE_OFFSET_HIGH:
+		ctx->offset |= byte << 8;
+		return match_start(ctx);
+	case STATE_MATCH_LEN:
+		ctx->match_len += byte;
+		if (byte == 0xff) {
+			return 0;
+		}
+		ctx->state = STATE_TOKEN;
+		return match_copy(ctx);
+	default:
+		return -EINVAL;
+	}
+
+	/* Literal length known */
+	if (output_check(ctx, ctx->literal_left)) {
+		return -EINVAL;
+	}
+
+	if (ctx->literal_left > 0) {
+		ctx->state = STATE_LITERALS;
+		return 0;
+	}
+
+	literals_done(ctx);
+
+	return 0;
+}
+
+static int header_put(struct lz4_stream_ctx *ctx, const uint8_t *data, size_t len)
+{
+	uint32_t window;
+
+	memcpy(&ctx->hdr[ctx->hdr_len], data, len);
+	ctx->hdr_len += len;
+
+	if (ctx->hdr_len < LZ4_STREAM_HDR_SIZE) {
+		return 0;
+	}
+
+	if (!lz4_stream_is_compressed(ctx->hdr, ctx->hdr_len)) {
+		LOG_ERR("Not a compressed image");
+		return -EINVAL;
+	}
+
+	ctx->size = sys_get_le32(&ctx->hdr[4]);
+	window = sys_get_le32(&ctx->hdr[8]);
+	if (window > WINDOW_SIZE) {
+		LOG_ERR("Compressed with a %u byte window, %u available", window, WINDOW_SIZE);
+		return -EINVAL;
+	}
+
+	LOG_INF("Compressed %u byte image, %u byte window", ctx->size, window);
+
+	ctx->state = (ctx->size > 0) ? STATE_TOKEN : STATE_END;
+
+	return 0;
+}
+
+bool lz4_stream_is_compressed(const uint8_t *data, size_t len)
+{
+	return len >= 4 && memcmp(data, LZ4_STREAM_MAGIC, 4) == 0;
+}
+
+void lz4_stream_init(struct lz4_stream_ctx *ctx, lz4_stream_write_t write, void *user)
+{
+	ctx->write = write;
+	ctx->user = user;
+	ctx->hdr_len = 0;
+	ctx->size = 0;
+	ctx->state = STATE_HEADER;
+	ctx->consumed = 0;
+	ctx->written = 0;
+}
+
+int lz4_stream_feed(struct lz4_stream_ctx *ctx, const uint8_t *data, size_t len)
+{
+	size_t n;
+	int err = 0;
+
+	while (len > 0 && !err) {
+		switch (ctx->state) {
+		case STATE_HEADER:
+			n = MIN(len, LZ4_STREAM_HDR_SIZE - ctx->hdr_len);
+			err = header_put(ctx, data, n);
+			break;
+		case STATE_LITERALS:
+			n = MIN(len, ctx->literal_left);
+			err = literals_put(ctx, data, n);
+			ctx->literal_left -= n;
+			if (!err && ctx->literal_left == 0) {
+				literals_done(ctx);
+			}
+			break;
+		case STATE_END:
+			LOG_ERR("Data after the end of the image");
+			return -EINVAL;
+		default:
+			n = 1;
+			err = sequence_put(ctx, *data);
+			break;
+		}
+
+		ctx->consumed += n;
+		data += n;
+		len -= n;
+	}
+
+	return err;
+}
+
+int lz4_stream_finish(struct lz4_stream_ctx *ctx)
+{
+	size_t tail = ctx->written & WINDOW_MASK;
+
+	if (ctx->state != STATE_END) {
+		LOG_ERR("Image incomplete, %u of %u bytes", ctx->written, ctx->size);
+		return -EBADMSG;
+	}
+
+	LOG_INF("%u bytes decompressed from %u", ctx->written, ctx->consumed);
+
+	return (tail > 0) ? ctx->write(ctx->user, ctx->window, tail) : 0;
+}
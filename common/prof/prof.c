@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <devacademy/prof.h>
+
+/* Probes are updated from interrupts, the table is copied under the lock */
+static struct k_spinlock lock;
+
+void prof_probe_record(struct prof_probe *probe, uint32_t cycles)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	probe->sum += cycles;
+	probe->count++;
+	probe->min = MIN(probe->min, cycles);
+	probe->max = MAX(probe->max, cycles);
+
+	k_spin_unlock(&lock, key);
+}
+
+static uint64_t cycles_to_ns(uint64_t cycles)
+{
+#if defined(CONFIG_DEVACADEMY_PROF_CLOCK_TIMING)
+	return timing_cycles_to_ns(cycles);
+#else
+	return k_cyc_to_ns_floor64(cycles);
+#endif
+}
+
+static void probe_get(struct prof_probe *probe, struct prof_probe *copy)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*copy = *probe;
+
+	k_spin_unlock(&lock, key);
+}
+
+void prof_report_print(void)
+{
+	printk("probe,count,min_cycles,max_cycles,mean_cycles,mean_ns\n");
+
+	STRUCT_SECTION_FOREACH(prof_probe, probe) {
+		struct prof_probe p;
+		uint64_t mean;
+
+		probe_get(probe, &p);
+		if (p.count == 0) {
+			continue;
+		}
+
+		mean = p.sum / p.count;
+		printk("%s,%u,%u,%u,%llu,%llu\n", p.name, p.count, p.min, p.max, mean,
+		       cycles_to_ns(mean));
+	}
+}
+
+void prof_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	STRUCT_SECTION_FOREACH(prof_probe, probe) {
+		probe->sum = 0;
+		probe->count = 0;
+		probe->min = UINT32_MAX;
+		probe->max = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+#if CONFIG_DEVACADEMY_PROF_REPORT_PERIOD_S > 0
+static void report_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+
+	prof_report_print();
+	k_work_schedule(dwork, K_SECONDS(CONFIG_DEVACADEMY_PROF_REPORT_PERIOD_S));
+}
+
+static K_WORK_DELAYABLE_DEFINE(report_work, report_handler);
+#endif
+
+static int prof_init(void)
+{
+	if (IS_ENABLED(CONFIG_DEVACADEMY_PROF_CLOCK_TIMING)) {
+		timing_init();
+		timing_start();
+	}
+
+#if CONFIG_DEVACADEMY_PROF_REPORT_PERIOD_S > 0
+	k_work_schedule(&report_work, K_SECONDS(CONFIG_DEVACADEMY_PROF_REPORT_PERIOD_S));
+#endif
+
+	return 0;
+}
+
+SYS_INIT(prof_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#if defined(CONFIG_DEVACADEMY_PROF_SHELL)
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "%-24s %8s %10s %10s %10s %10s", "probe", "count", "min", "max", "mean",
+		    "mean ns");
+
+	STRUCT_SECTION_FOREACH(prof_probe, probe) {
+		struct prof_probe p;
+		uint64_t mean;
+
+		probe_get(probe, &p);
+		if (p.count == 0) {
+			shell_print(sh, "%-24.24s %8u", p.name, 0);
+			continue;
+		}
+
+		mean = p.sum / p.count;
+		shell_print(sh, "%-24.24s %8u %10u %10u %10llu %10llu", p.name, p.count, p.min,
+			    p.max, mean, cycles_to_ns(mean));
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	prof_reset();
+	shell_print(sh, "Probes cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(prof_cmds,
+	SHELL_CMD(show, NULL, "Print the statistics of all probes", cmd_show),
+	SHELL_CMD(reset, NULL, "Clear the statistics of all probes", cmd_reset),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(prof, &prof_cmds, "Cycle counting probes", NULL);
+
+#endif /* CONFIG_DEVACADEMY_PROF_SHELL */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Drains the log records forwarded by a remote core through
+ * remote_console_backend.c into the log of this core.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_msg.h>
+
+#include <devacademy/remote_console.h>
+#include <devacademy/shm_ring.h>
+
+/* Also the highest level of the forwarded records */
+LOG_MODULE_REGISTER(remote_console, CONFIG_DEVACADEMY_REMOTE_CONSOLE_LOG_LEVEL);
+
+#define REMOTE_CONSOLE_NODE DT_CHOSEN(devacademy_remote_console)
+
+static struct shm_ring ring;
+static bool ring_attached;
+
+/* Timestamp of the record being forwarded, see timestamp_get() */
+static uint32_t record_timestamp_us;
+static bool record_forwarding;
+
+static void drain_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(drain_work, drain_handler);
+
+/* Log timestamps in microseconds, so that a forwarded message keeps the time
+ * it was logged at on the remote core. Messages created on this core by
+ * anything else than the drain keep the local time.
+ */
+static log_timestamp_t timestamp_get(void)
+{
+	if (record_forwarding && !k_is_in_isr() &&
+	    k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
+		return record_timestamp_us;
+	}
+
+	return (log_timestamp_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static void record_log(const struct remote_console_record *rec, size_t text_len)
+{
+	static char text[CONFIG_DEVACADEMY_REMOTE_CONSOLE_LINE_SIZE + 1];
+	char source[sizeof(rec->source) + 1];
+
+	memcpy(source, rec->source, sizeof(rec->source));
+	source[sizeof(rec->source)] = '\0';
+
+	if (rec->dropped) {
+		LOG_WRN("%s: %u messages dropped", source, rec->dropped);
+	}
+
+	if (rec->level > CONFIG_DEVACADEMY_REMOTE_CONSOLE_LOG_LEVEL) {
+		return;
+	}
+
+	text_len = MIN(text_len, sizeof(text) - 1);
+	memcpy(text, rec + 1, text_len);
+	text[text_len] = '\0';
+
+	record_timestamp_us = rec->timestamp_us;
+	record_forwarding = true;
+
+	/* The strings are copied into the message. Level 0 is printk output, printed
+	 * raw as LOG_PRINTK does. Other records already start with the name of their
+	 * module on the remote core, prefixed here with the name of that core.
+	 */
+	if (rec->level == LOG_LEVEL_NONE) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, NULL, LOG_LEVEL_INTERNAL_RAW_STRING,
+					 NULL, 0, 0, "%s\n", text);
+	} else {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, NULL, rec->level, NULL, 0, 0,
+					 "%s/%s", source, text);
+	}
+
+	record_forwarding = false;
+}
+
+static void drain_handler(struct k_work *work)
+{
+	const struct remote_console_record *rec;
+	size_t len;
+
+	if (!ring_attached) {
+		/* -EAGAIN until the remote core has initialized its backend */
+		ring_attached = shm_ring_consumer_init(&ring,
+						       (void *)DT_REG_ADDR(REMOTE_CONSOLE_NODE),
+						       DT_REG_SIZE(REMOTE_CONSOLE_NODE)) == 0;
+	}
+
+	while (ring_attached && (rec = shm_ring_peek(&ring, &len)) != NULL) {
+		if (len >= sizeof(*rec)) {
+			record_log(rec, len - sizeof(*rec));
+		}
+		shm_ring_release(&ring);
+	}
+
+	k_work_schedule(&drain_work, K_MSEC(CONFIG_DEVACADEMY_REMOTE_CONSOLE_POLL_MS));
+}
+
+static int remote_console_init(void)
+{
+	log_set_timestamp_func(timestamp_get, USEC_PER_SEC);
+	k_work_schedule(&drain_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(remote_console_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Log backend of a remote core: each message is formatted into a line and
+ * written as a record into the shared memory ring of the
+ * devacademy,remote-console chosen region, read by remote_console.c on the
+ * application core.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+
+#include <devacademy/remote_console.h>
+#include <devacademy/shm_ring.h>
+
+#define REMOTE_CONSOLE_NODE DT_CHOSEN(devacademy_remote_console)
+
+static struct shm_ring ring;
+static bool ring_ready;
+static uint32_t dropped;
+
+static char line[CONFIG_DEVACADEMY_REMOTE_CONSOLE_LINE_SIZE];
+static size_t line_len;
+static uint8_t output_buf[32];
+
+static int line_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t n = MIN(length, sizeof(line) - line_len);
+
+	memcpy(&line[line_len], data, n);
+	line_len += n;
+
+	/* Truncated, but consumed */
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(remote_console_output, line_out, output_buf, sizeof(output_buf));
+
+static void record_push(struct log_msg *msg)
+{
+	struct remote_console_record *rec;
+
+	while (line_len > 0 && (line[line_len - 1] == '\n' || line[line_len - 1] == '\r')) {
+		line_len--;
+	}
+
+	rec = shm_ring_claim(&ring, sizeof(*rec) + line_len);
+	if (rec == NULL) {
+		dropped++;
+		return;
+	}
+
+	rec->timestamp_us = log_output_timestamp_to_us(log_msg_get_timestamp(msg));
+	rec->dropped = MIN(dropped, UINT16_MAX);
+	rec->level = log_msg_get_level(msg);
+	rec->reserved = 0;
+	memset(rec->source, 0, sizeof(rec->source));
+	memcpy(rec->source, CONFIG_DEVACADEMY_REMOTE_CONSOLE_SOURCE,
+	       MIN(sizeof(CONFIG_DEVACADEMY_REMOTE_CONSOLE_SOURCE) - 1, sizeof(rec->source)));
+	memcpy(rec + 1, line, line_len);
+
+	/* The application core polls the ring, no notification */
+	(void)shm_ring_commit(&ring, sizeof(*rec) + line_len);
+	dropped = 0;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	if (!ring_ready) {
+		return;
+	}
+
+	line_len = 0;
+	log_output_msg_process(&remote_console_output, &msg->log, LOG_OUTPUT_FLAG_CRLF_NONE);
+	record_push(&msg->log);
+}
+
+static void dropped_cb(const struct log_backend *const backend, uint32_t cnt)
+{
+	dropped += cnt;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	/* Writing into the ring never blocks, nothing to change */
+}
+
+static void init(const struct log_backend *const backend)
+{
+	ring_ready = shm_ring_producer_init(&ring, (void *)DT_REG_ADDR(REMOTE_CONSOLE_NODE),
+					    DT_REG_SIZE(REMOTE_CONSOLE_NODE)) == 0;
+}
+
+static const struct log_backend_api remote_console_backend_api = {
+	.process = process,
+	.dropped = dropped_cb,
+	.panic = panic,
+	.init = init,
+};
+
+LOG_BACKEND_DEFINE(remote_console_backend, remote_console_backend_api, true);
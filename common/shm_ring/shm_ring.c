@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Single-producer single-consumer ring of variable size records.
+ *
+ * Indexes are free running line counts: the producer only writes head, the
+ * consumer only writes tail, and each lives on its own line. A record that
+ * does not fit before the end of the data area is preceded by a padding
+ * record covering the remaining lines, so payloads are always contiguous.
+ *
+ * The producer reads tail after publishing head and the consumer reads head
+ * after publishing tail, with a full barrier in between on both sides. If
+ * the producer sees the ring empty before its commit, the consumer has
+ * either not yet looked at head or will look again, so notifying only on
+ * that transition never loses a record.
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/cache.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/util.h>
+
+#include <devacademy/shm_ring.h>
+
+#define LINE			  CONFIG_DEVACADEMY_SHM_RING_LINE_SIZE
+#define SHM_RING_MAGIC		  0x53524e47 /* "SRNG" */
+#define SHM_RING_HDR_SIZE	  sizeof(uint32_t)
+#define SHM_RING_PAD		  BIT(31)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(LINE) && LINE >= 8, "Line size must be a power of two");
+
+struct shm_ring_ctrl {
+	struct {
+		volatile uint32_t magic;
+		volatile uint32_t line_count;
+	} __aligned(LINE) info;
+	struct {
+		volatile uint32_t value;
+	} __aligned(LINE) head;
+	struct {
+		volatile uint32_t value;
+	} __aligned(LINE) tail;
+};
+
+static inline void line_flush(volatile void *addr, size_t size)
+{
+	sys_cache_data_flush_range((void *)addr, ROUND_UP(size, LINE));
+}
+
+static inline void line_invd(volatile void *addr, size_t size)
+{
+	sys_cache_data_invd_range((void *)addr, ROUND_UP(size, LINE));
+}
+
+static uint32_t index_read(volatile uint32_t *index)
+{
+	line_invd(index, sizeof(*index));
+	return *index;
+}
+
+static void index_write(volatile uint32_t *index, uint32_t value)
+{
+	*index = value;
+	line_flush(index, sizeof(*index));
+}
+
+static inline uint8_t *line_ptr(const struct shm_ring *ring, uint32_t index)
+{
+	return ring->data + (size_t)(index % ring->line_count) * LINE;
+}
+
+static int ring_setup(struct shm_ring *ring, void *mem, size_t size)
+{
+	if (((uintptr_t)mem % LINE) != 0 || size < sizeof(struct shm_ring_ctrl) + 2 * LINE) {
+		return -EINVAL;
+	}
+
+	ring->ctrl = mem;
+	ring->data = (uint8_t *)mem + sizeof(struct shm_ring_ctrl);
+	ring->line_count = (size - sizeof(struct shm_ring_ctrl)) / LINE;
+	ring->claim_index = 0;
+	ring->pending_lines = 0;
+
+	return 0;
+}
+
+int shm_ring_producer_init(struct shm_ring *ring, void *mem, size_t size)
+{
+	struct shm_ring_ctrl *ctrl;
+	int err;
+
+	err = ring_setup(ring, mem, size);
+	if (err) {
+		return err;
+	}
+
+	ctrl = ring->ctrl;
+	ctrl->info.magic = 0;
+	ctrl->info.line_count = ring->line_count;
+	line_flush(&ctrl->info, sizeof(ctrl->info));
+	index_write(&ctrl->head.value, 0);
+	index_write(&ctrl->tail.value, 0);
+
+	barrier_dmem_fence_full();
+
+	ctrl->info.magic = SHM_RING_MAGIC;
+	line_flush(&ctrl->info, sizeof(ctrl->info));
+
+	return 0;
+}
+
+int shm_ring_consumer_init(struct shm_ring *ring, void *mem, size_t size)
+{
+	struct shm_ring_ctrl *ctrl;
+	int err;
+
+	err = ring_setup(ring, mem, size);
+	if (err) {
+		return err;
+	}
+
+	ctrl = ring->ctrl;
+	line_invd(&ctrl->info, sizeof(ctrl->info));
+	if (ctrl->info.magic != SHM_RING_MAGIC) {
+		return -EAGAIN;
+	}
+
+	barrier_dmem_fence_full();
+
+	if (ctrl->info.line_count != ring->line_count) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+size_t shm_ring_max_payload(const struct shm_ring *ring)
+{
+	/* Worst case a record has to be preceded by a padding record of the same size. */
+	return (ring->line_count / 2) * LINE - SHM_RING_HDR_SIZE;
+}
+
+void *shm_ring_claim(struct shm_ring *ring, size_t len)
+{
+	struct shm_ring_ctrl *ctrl = ring->ctrl;
+	uint32_t head = ctrl->head.value;
+	uint32_t tail = index_read(&ctrl->tail.value);
+	uint32_t lines = DIV_ROUND_UP(SHM_RING_HDR_SIZE + len, LINE);
+	uint32_t to_end = ring->line_count - (head % ring->line_count);
+	uint32_t needed = (lines > to_end) ? lines + to_end : lines;
+	uint32_t free = ring->line_count - (head - tail);
+
+	if (len > shm_ring_max_payload(ring) || needed > free) {
+		return NULL;
+	}
+
+	if (needed != lines) {
+		uint32_t *pad = (uint32_t *)line_ptr(ring, head);
+
+		*pad = SHM_RING_PAD | to_end;
+		line_flush(pad, SHM_RING_HDR_SIZE);
+		head += to_end;
+	}
+
+	ring->claim_index = head;
+	ring->pending_lines = needed;
+
+	return line_ptr(ring, head) + SHM_RING_HDR_SIZE;
+}
+
+bool shm_ring_commit(struct shm_ring *ring, size_t len)
+{
+	struct shm_ring_ctrl *ctrl = ring->ctrl;
+	uint32_t old_head = ctrl->head.value;
+	uint32_t *hdr = (uint32_t *)line_ptr(ring, ring->claim_index);
+	/* Padding before the record, then the lines the consumer derives from len */
+	uint32_t lines = (ring->claim_index - old_head) +
+			 DIV_ROUND_UP(SHM_RING_HDR_SIZE + len, LINE);
+	uint32_t tail;
+
+	__ASSERT(ring->pending_lines > 0, "Nothing claimed");
+	__ASSERT(lines <= ring->pending_lines, "Commit longer than the claim");
+
+	*hdr = len;
+	line_flush(hdr, SHM_RING_HDR_SIZE + len);
+
+	barrier_dmem_fence_full();
+	index_write(&ctrl->head.value, old_head + lines);
+	ring->pending_lines = 0;
+
+	barrier_dmem_fence_full();
+	tail = index_read(&ctrl->tail.value);
+
+	return tail == old_head;
+}
+
+const void *shm_ring_peek(struct shm_ring *ring, size_t *len)
+{
+	struct shm_ring_ctrl *ctrl = ring->ctrl;
+	uint32_t tail = ctrl->tail.value;
+	uint32_t head = index_read(&ctrl->head.value);
+	uint32_t pad_lines = 0;
+	uint32_t *hdr;
+
+	if (head == tail) {
+		return NULL;
+	}
+
+	barrier_dmem_fence_full();
+
+	hdr = (uint32_t *)line_ptr(ring, tail);
+	line_invd(hdr, SHM_RING_HDR_SIZE);
+
+	if (*hdr & SHM_RING_PAD) {
+		pad_lines = *hdr & ~SHM_RING_PAD;
+		hdr = (uint32_t *)line_ptr(ring, tail + pad_lines);
+		line_invd(hdr, SHM_RING_HDR_SIZE);
+	}
+
+	*len = *hdr;
+	line_invd(hdr, SHM_RING_HDR_SIZE + *len);
+	ring->pending_lines = pad_lines + DIV_ROUND_UP(SHM_RING_HDR_SIZE + *len, LINE);
+
+	return (uint8_t *)hdr + SHM_RING_HDR_SIZE;
+}
+
+void shm_ring_release(struct shm_ring *ring)
+{
+	struct shm_ring_ctrl *ctrl = ring->ctrl;
+
+	__ASSERT(ring->pending_lines > 0, "Nothing peeked");
+
+	/* Payload reads must complete before the producer may reuse the lines. */
+	barrier_dmem_fence_full();
+	index_write(&ctrl->tail.value, ctrl->tail.value + ring->pending_lines);
+	ring->pending_lines = 0;
+}
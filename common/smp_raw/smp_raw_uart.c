@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* mcumgr transport exchanging raw SMP packets on the UART of the
+ * devacademy,smp-raw chosen node.
+ *
+ * Packets are framed by the length in their header only. They are received
+ * from the UART interrupt into a buffer of the SMP packet pool each and
+ * handed to the SMP work queue, so the next request arrives while the
+ * previous one is written to flash. Responses go through a ring buffer
+ * drained by the same interrupt.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/mgmt/mcumgr/mgmt/handlers.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zephyr/mgmt/mcumgr/transport/smp.h>
+
+LOG_MODULE_REGISTER(smp_raw, CONFIG_DEVACADEMY_SMP_RAW_LOG_LEVEL);
+
+#define SMP_RAW_NODE	DT_CHOSEN(devacademy_smp_raw)
+#define SMP_HDR_SIZE	8
+#define SMP_OP_MASK	0x07
+#define SMP_OP_READ	0
+#define SMP_OP_WRITE	2
+
+static const struct device *const uart = DEVICE_DT_GET(SMP_RAW_NODE);
+static struct smp_transport smp_raw_transport;
+
+RING_BUF_DECLARE(tx_ring, CONFIG_DEVACADEMY_SMP_RAW_TX_BUF_SIZE);
+static K_SEM_DEFINE(tx_space, 0, 1);
+
+/* Packet being received, only touched from the UART interrupt */
+static struct {
+	uint8_t hdr[SMP_HDR_SIZE];
+	size_t hdr_len;
+	struct net_buf *nb;
+	/* Body bytes still to come, dropped if there is no buffer */
+	size_t body_left;
+	uint32_t last_ms;
+} rx;
+
+static bool header_valid(const uint8_t *hdr)
+{
+	uint8_t op = hdr[0] & SMP_OP_MASK;
+
+	return (op == SMP_OP_READ || op == SMP_OP_WRITE) &&
+	       SMP_HDR_SIZE + sys_get_be16(&hdr[2]) <= CONFIG_MCUMGR_TRANSPORT_NETBUF_SIZE;
+}
+
+static void rx_reset(void)
+{
+	if (rx.nb) {
+		smp_packet_free(rx.nb);
+		rx.nb = NULL;
+	}
+	rx.hdr_len = 0;
+	rx.body_left = 0;
+}
+
+static void rx_done(void)
+{
+	if (rx.nb) {
+		smp_rx_req(&smp_raw_transport, rx.nb);
+		rx.nb = NULL;
+	}
+	rx.hdr_len = 0;
+}
+
+static void header_put(uint8_t byte)
+{
+	rx.hdr[rx.hdr_len++] = byte;
+	if (rx.hdr_len < SMP_HDR_SIZE) {
+		return;
+	}
+
+	/* Resynchronize one byte at a time on garbage */
+	if (!header_valid(rx.hdr)) {
+		memmove(rx.hdr, &rx.hdr[1], SMP_HDR_SIZE - 1);
+		rx.hdr_len--;
+		return;
+	}
+
+	rx.body_left = sys_get_be16(&rx.hdr[2]);
+	rx.nb = smp_packet_alloc();
+	if (rx.nb) {
+		net_buf_add_mem(rx.nb, rx.hdr, SMP_HDR_SIZE);
+	} else {
+		LOG_WRN("No SMP buffer, request of %zu bytes dropped", rx.body_left);
+	}
+
+	if (rx.body_left == 0) {
+		rx_done();
+	}
+}
+
+static void rx_put(const uint8_t *data, size_t len)
+{
+	uint32_t now = k_uptime_get_32();
+
+	if ((rx.hdr_len > 0) && (now - rx.last_ms > CONFIG_DEVACADEMY_SMP_RAW_GAP_MS)) {
+		rx_reset();
+	}
+	rx.last_ms = now;
+
+	while (len > 0) {
+		size_t n;
+
+		if (rx.hdr_len < SMP_HDR_SIZE) {
+			header_put(*data);
+			n = 1;
+		} else {
+			n = MIN(len, rx.body_left);
+			if (rx.nb) {
+				net_buf_add_mem(rx.nb, data, n);
+			}
+			rx.body_left -= n;
+			if (rx.body_left == 0) {
+				rx_done();
+			}
+		}
+
+		data += n;
+		len -= n;
+	}
+}
+
+static void uart_isr(const struct device *dev, void *user_data)
+{
+	uint8_t buf[64];
+	uint8_t *data;
+	uint32_t len;
+	int n;
+
+	while (uart_irq_update(dev) && uart_irq_is_pending(dev)) {
+		if (uart_irq_rx_ready(dev)) {
+			n = uart_fifo_read(dev, buf, sizeof(buf));
+			if (n > 0) {
+				rx_put(buf, n);
+			}
+		}
+
+		if (uart_irq_tx_ready(dev)) {
+			len = ring_buf_get_claim(&tx_ring, &data, CONFIG_DEVACADEMY_SMP_RAW_TX_BUF_SIZE);
+			if (len == 0) {
+				uart_irq_tx_disable(dev);
+				continue;
+			}
+
+			n = uart_fifo_fill(dev, data, len);
+			ring_buf_get_finish(&tx_ring, MAX(n, 0));
+			k_sem_give(&tx_space);
+		}
+	}
+}
+
+/* Called from the SMP work queue, the only writer of the ring */
+static int smp_raw_output(struct net_buf *nb)
+{
+	const uint8_t *data = nb->data;
+	size_t len = nb->len;
+
+	while (len > 0) {
+		uint32_t n = ring_buf_put(&tx_ring, data, len);
+
+		data += n;
+		len -= n;
+		uart_irq_tx_enable(uart);
+
+		if (len > 0) {
+			k_sem_take(&tx_space, K_FOREVER);
+		}
+	}
+
+	smp_packet_free(nb);
+
+	return 0;
+}
+
+static uint16_t smp_raw_get_mtu(const struct net_buf *nb)
+{
+	return CONFIG_MCUMGR_TRANSPORT_NETBUF_SIZE;
+}
+
+static void smp_raw_start(void)
+{
+	int err;
+
+	if (!device_is_ready(uart)) {
+		LOG_ERR("%s not ready", uart->name);
+		return;
+	}
+
+	smp_raw_transport.functions.output = smp_raw_output;
+	smp_raw_transport.functions.get_mtu = smp_raw_get_mtu;
+
+	err = smp_transport_init(&smp_raw_transport);
+	if (err) {
+		LOG_ERR("smp_transport_init, error: %d", err);
+		return;
+	}
+
+	err = uart_irq_callback_user_data_set(uart, uart_isr, NULL);
+	if (err) {
+		LOG_ERR("uart_irq_callback_user_data_set, error: %d", err);
+		return;
+	}
+
+	uart_irq_rx_enable(uart);
+
+	LOG_INF("Raw SMP on %s, MTU %u", uart->name, CONFIG_MCUMGR_TRANSPORT_NETBUF_SIZE);
+}
+
+MCUMGR_HANDLER_DEFINE(smp_raw, smp_raw_start);
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+
+#include <devacademy/thread_stats.h>
+
+LOG_MODULE_REGISTER(thread_stats, LOG_LEVEL_INF);
+
+#define RECORD_MAX_SIZE                                                                            \
+	(sizeof(struct thread_stats_hdr) +                                                         \
+	 CONFIG_DEVACADEMY_THREAD_STATS_MAX_THREADS * sizeof(struct thread_stats_thread) +         \
+	 CONFIG_DEVACADEMY_THREAD_STATS_MAX_QUEUES * sizeof(struct thread_stats_queue))
+
+struct queue_entry {
+	char name[THREAD_STATS_NAME_LEN];
+	thread_stats_depth_cb depth;
+	uint32_t capacity;
+	void *user_data;
+	uint32_t peak;
+};
+
+/* Execution cycles of a thread at the previous sample, to compute its load. */
+struct thread_cycles {
+	const struct k_thread *thread;
+	uint64_t cycles;
+};
+
+struct sample_ctx {
+	struct thread_stats_thread threads[CONFIG_DEVACADEMY_THREAD_STATS_MAX_THREADS];
+	struct thread_cycles cycles[CONFIG_DEVACADEMY_THREAD_STATS_MAX_THREADS];
+	uint8_t count;
+	uint64_t period_cycles;
+};
+
+static K_MUTEX_DEFINE(stats_lock);
+static struct queue_entry queues[CONFIG_DEVACADEMY_THREAD_STATS_MAX_QUEUES];
+static uint8_t queue_count;
+
+static uint8_t record[RECORD_MAX_SIZE];
+static size_t record_len;
+
+/* Only used by the sampling thread */
+static struct sample_ctx sample;
+static struct thread_cycles prev_cycles[CONFIG_DEVACADEMY_THREAD_STATS_MAX_THREADS];
+static uint8_t prev_count;
+
+static K_SEM_DEFINE(sample_sem, 0, 1);
+
+static void sample_timer_handler(struct k_timer *timer)
+{
+	k_sem_give(&sample_sem);
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_timer_handler, NULL);
+
+static uint16_t permille(uint64_t part, uint64_t total)
+{
+	if (total == 0) {
+		return 0;
+	}
+
+	return (uint16_t)MIN((part * 1000U) / total, 1000U);
+}
+
+static void name_copy(char *dst, const char *src)
+{
+	memset(dst, 0, THREAD_STATS_NAME_LEN);
+	strncpy(dst, src, THREAD_STATS_NAME_LEN);
+}
+
+static uint64_t prev_cycles_find(const struct k_thread *thread)
+{
+	for (uint8_t i = 0; i < prev_count; i++) {
+		if (prev_cycles[i].thread == thread) {
+			return prev_cycles[i].cycles;
+		}
+	}
+
+	/* Thread created since the previous sample */
+	return 0;
+}
+
+static void thread_sample(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct sample_ctx *ctx = user_data;
+	struct thread_stats_thread *entry;
+	k_thread_runtime_stats_t stats;
+	const char *name;
+	char addr[12];
+	size_t unused = 0;
+
+	if (ctx->count >= ARRAY_SIZE(ctx->threads)) {
+		return;
+	}
+
+	entry = &ctx->threads[ctx->count];
+
+	name = k_thread_name_get(thread);
+	if (name == NULL || name[0] == '\0') {
+		snprintk(addr, sizeof(addr), "%08lx", (unsigned long)(uintptr_t)thread);
+		name = addr;
+	}
+	name_copy(entry->name, name);
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		stats.execution_cycles = 0;
+	}
+
+	(void)k_thread_stack_space_get(thread, &unused);
+
+	entry->priority = (int8_t)k_thread_priority_get(thread);
+	entry->reserved = 0;
+	entry->load = permille(stats.execution_cycles - prev_cycles_find(thread),
+			       ctx->period_cycles);
+	entry->stack_size = (uint16_t)MIN(thread->stack_info.size, UINT16_MAX);
+	entry->stack_unused = (uint16_t)MIN(unused, UINT16_MAX);
+
+	ctx->cycles[ctx->count].thread = thread;
+	ctx->cycles[ctx->count].cycles = stats.execution_cycles;
+	ctx->count++;
+}
+
+static void record_build(uint32_t period_ms)
+{
+	static k_thread_runtime_stats_t prev_all;
+	k_thread_runtime_stats_t all;
+	struct thread_stats_hdr hdr;
+	uint8_t *pos;
+
+	k_thread_runtime_stats_all_get(&all);
+
+	sample.count = 0;
+	sample.period_cycles = all.execution_cycles - prev_all.execution_cycles;
+
+	/* Stack scanning is slow, do not hold the thread list lock for it */
+	k_thread_foreach_unlocked(thread_sample, &sample);
+
+	memcpy(prev_cycles, sample.cycles, sizeof(prev_cycles));
+	prev_count = sample.count;
+
+	hdr.version = THREAD_STATS_VERSION;
+	hdr.thread_count = sample.count;
+	hdr.reserved = 0;
+	hdr.uptime_ms = k_uptime_get_32();
+	hdr.cpu_load = permille(all.total_cycles - prev_all.total_cycles, sample.period_cycles);
+	hdr.period_ms = (uint16_t)MIN(period_ms, UINT16_MAX);
+
+	prev_all = all;
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	hdr.queue_count = queue_count;
+	pos = record + sizeof(hdr);
+
+	memcpy(pos, sample.threads, sample.count * sizeof(struct thread_stats_thread));
+	pos += sample.count * sizeof(struct thread_stats_thread);
+
+	for (uint8_t i = 0; i < queue_count; i++) {
+		struct queue_entry *q = &queues[i];
+		struct thread_stats_queue entry;
+		uint32_t used = q->depth(q->user_data);
+
+		q->peak = MAX(q->peak, used);
+
+		memcpy(entry.name, q->name, sizeof(entry.name));
+		entry.used = (uint16_t)MIN(used, UINT16_MAX);
+		entry.peak = (uint16_t)MIN(q->peak, UINT16_MAX);
+		entry.capacity = (uint16_t)MIN(q->capacity, UINT16_MAX);
+		entry.reserved = 0;
+
+		memcpy(pos, &entry, sizeof(entry));
+		pos += sizeof(entry);
+	}
+
+	memcpy(record, &hdr, sizeof(hdr));
+	record_len = pos - record;
+
+	if (IS_ENABLED(CONFIG_DEVACADEMY_THREAD_STATS_LOG)) {
+		LOG_HEXDUMP_INF(record, record_len, "record");
+	}
+
+	k_mutex_unlock(&stats_lock);
+}
+
+static void thread_stats_thread(void *unused1, void *unused2, void *unused3)
+{
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
+
+	int64_t last = k_uptime_get();
+
+	/* Establish the baseline so the first record covers one full period */
+	record_build(0);
+
+	k_timer_start(&sample_timer, K_MSEC(CONFIG_DEVACADEMY_THREAD_STATS_PERIOD_MS),
+		      K_MSEC(CONFIG_DEVACADEMY_THREAD_STATS_PERIOD_MS));
+
+	while (1) {
+		int64_t now;
+
+		k_sem_take(&sample_sem, K_FOREVER);
+
+		now = k_uptime_get();
+		record_build((uint32_t)(now - last));
+		last = now;
+	}
+}
+
+K_THREAD_DEFINE(thread_stats, CONFIG_DEVACADEMY_THREAD_STATS_STACK_SIZE, thread_stats_thread, NULL,
+		NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+int thread_stats_queue_register(const char *name, thread_stats_depth_cb depth, uint32_t capacity,
+				void *user_data)
+{
+	struct queue_entry *q;
+
+	if (name == NULL || depth == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	if (queue_count >= ARRAY_SIZE(queues)) {
+		k_mutex_unlock(&stats_lock);
+		return -ENOMEM;
+	}
+
+	q = &queues[queue_count];
+	name_copy(q->name, name);
+	q->depth = depth;
+	q->capacity = capacity;
+	q->user_data = user_data;
+	q->peak = 0;
+	queue_count++;
+
+	k_mutex_unlock(&stats_lock);
+
+	return 0;
+}
+
+static uint32_t msgq_depth(void *user_data)
+{
+	return k_msgq_num_used_get(user_data);
+}
+
+int thread_stats_msgq_register(const char *name, struct k_msgq *msgq)
+{
+	return thread_stats_queue_register(name, msgq_depth, msgq->max_msgs, msgq);
+}
+
+int thread_stats_record_get(uint8_t *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&stats_lock, K_FOREVER);
+
+	if (len < record_len) {
+		ret = -ENOMEM;
+	} else {
+		memcpy(buf, record, record_len);
+		ret = record_len;
+	}
+
+	k_mutex_unlock(&stats_lock);
+
+	return ret;
+}
+
+#if defined(CONFIG_DEVACADEMY_THREAD_STATS_SHELL)
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	static uint8_t buf[RECORD_MAX_SIZE];
+	struct thread_stats_hdr hdr;
+	const uint8_t *pos;
+	int len;
+
+	len = thread_stats_record_get(buf, sizeof(buf));
+	if (len <= 0) {
+		shell_print(sh, "No record available yet");
+		return 0;
+	}
+
+	memcpy(&hdr, buf, sizeof(hdr));
+	pos = buf + sizeof(hdr);
+
+	shell_print(sh, "Uptime %u ms, period %u ms, CPU load %u.%u %%", hdr.uptime_ms,
+		    hdr.period_ms, hdr.cpu_load / 10, hdr.cpu_load % 10);
+	shell_print(sh, "%-8s %5s %7s %11s", "thread", "prio", "load %", "stack free");
+
+	for (uint8_t i = 0; i < hdr.thread_count; i++) {
+		struct thread_stats_thread t;
+
+		memcpy(&t, pos, sizeof(t));
+		pos += sizeof(t);
+
+		shell_print(sh, "%-8.8s %5d %5u.%u %5u/%-5u", t.name, t.priority, t.load / 10,
+			    t.load % 10, t.stack_unused, t.stack_size);
+	}
+
+	if (hdr.queue_count > 0) {
+		shell_print(sh, "%-8s %5s %5s %8s", "queue", "used", "peak", "capacity");
+	}
+
+	for (uint8_t i = 0; i < hdr.queue_count; i++) {
+		struct thread_stats_queue q;
+
+		memcpy(&q, pos, sizeof(q));
+		pos += sizeof(q);
+
+		shell_print(sh, "%-8.8s %5u %5u %8u", q.name, q.used, q.peak, q.capacity);
+	}
+
+	return 0;
+}
+
+static int cmd_record(const struct shell *sh, size_t argc, char **argv)
+{
+	static uint8_t buf[RECORD_MAX_SIZE];
+	int len;
+
+	len = thread_stats_record_get(buf, sizeof(buf));
+	if (len <= 0) {
+		shell_print(sh, "No record available yet");
+		return 0;
+	}
+
+	shell_hexdump(sh, buf, len);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(thread_stats_cmds,
+	SHELL_CMD(show, NULL, "Print the last record", cmd_show),
+	SHELL_CMD(record, NULL, "Print the last record as a hex dump", cmd_record),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(thread_stats, &thread_stats_cmds, "Thread and queue statistics", NULL);
+
+#endif /* CONFIG_DEVACADEMY_THREAD_STATS_SHELL */
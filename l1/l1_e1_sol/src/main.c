@@ -7,6 +7,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
+#include <devacademy/thread_stats.h>
+#include <devacademy/trace_points.h>
 
 /* The devicetree node identifier for the "led0"  and "led1" alias. */
 #define LED0_NODE DT_ALIAS(led0)
@@ -72,6 +74,9 @@ int main(void)
 	/* start periodic timer that expires once every 0.5 second  */
 	k_timer_start(&timer0, K_MSEC(500), K_MSEC(500));
 
+	/* Report the queue depth with the thread statistics, when enabled */
+	thread_stats_msgq_register("sensor", &device_message_queue);
+
 	return 0;
 }
 
@@ -85,6 +90,7 @@ static void producer_func(void *unused1, void *unused2, void *unused3)
 		static SensorReading acc_val = {100, 100, 100};
 		int ret;
 		/* STEP 3.3 - Write messages to the message queue */
+		TRACE_STAGE_BEGIN("l1_msgq", acc_val.x_reading);
 		ret = k_msgq_put(&device_message_queue, &acc_val, K_FOREVER);
 		if (ret) {
 			LOG_ERR("Return value from k_msgq_put = %d", ret);
@@ -111,8 +117,11 @@ static void consumer_func(void *unused1, void *unused2, void *unused3)
 		if (ret) {
 			LOG_ERR("Return value from k_msgq_get = %d", ret);
 		}
+		TRACE_STAGE_END("l1_msgq", temp.x_reading);
+		TRACE_STAGE_BEGIN("l1_log", temp.x_reading);
 		LOG_INF("Values got from the queue: %d.%d.%d\r\n", temp.x_reading, temp.y_reading,
 			temp.z_reading);
+		TRACE_STAGE_END("l1_log", temp.x_reading);
 	}
 }
 
@@ -8,6 +8,8 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/random/random.h>
+#include <devacademy/thread_stats.h>
+#include <devacademy/trace_points.h>
 /* The devicetree node identifier for the "led0"  and "led1" alias. */
 #define LED0_NODE DT_ALIAS(led0)
 #define LED1_NODE DT_ALIAS(led1)
@@ -31,11 +33,20 @@ struct data_item_t {
 	void *fifo_reserved;
 	uint8_t data[MAX_DATA_SIZE];
 	uint16_t len;
+	uint32_t seq;
 };
 
 /* STEP 3 - Define the FIFO */
 K_FIFO_DEFINE(my_fifo);
 
+/* A FIFO does not track its length, count the items for the thread statistics */
+static atomic_t fifo_items;
+
+static uint32_t fifo_depth(void *user_data)
+{
+	return atomic_get(&fifo_items);
+}
+
 static void timer0_handler(struct k_timer *dummy)
 {
 
@@ -71,6 +82,11 @@ int main(void)
 	/* start periodic timer that expires once every 0.5 second  */
 	k_timer_start(&timer0, K_MSEC(500), K_MSEC(500));
 
+	/* Report the FIFO depth with the thread statistics, when enabled.
+	 * The FIFO is unbounded, its items come from the heap.
+	 */
+	thread_stats_queue_register("fifo", fifo_depth, 0, NULL);
+
 	return 0;
 }
 
@@ -98,7 +114,10 @@ static void producer_func(void *unused1, void *unused2, void *unused3)
 			bytes_written = snprintf(buf->data, MAX_DATA_SIZE, "Data Seq. %u:\t%u",
 						 dataitem_count, sys_rand32_get());
 			buf->len = bytes_written;
+			buf->seq = dataitem_count;
 			dataitem_count++;
+			atomic_inc(&fifo_items);
+			TRACE_STAGE_BEGIN("l1_fifo", buf->seq);
 			k_fifo_put(&my_fifo, buf);
 		}
 		LOG_INF("Producer: Data Items Generated: %u", data_number);
@@ -115,7 +134,11 @@ static void consumer_func(void *unused1, void *unused2, void *unused3)
 	while (1) {
 		struct data_item_t *rec_item;
 		rec_item = k_fifo_get(&my_fifo, K_FOREVER);
+		atomic_dec(&fifo_items);
+		TRACE_STAGE_END("l1_fifo", rec_item->seq);
+		TRACE_STAGE_BEGIN("l1_log", rec_item->seq);
 		LOG_INF("Consumer: %s\tSize: %u", rec_item->data, rec_item->len);
+		TRACE_STAGE_END("l1_log", rec_item->seq);
 		k_free(rec_item);
 	}
 }
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Core dump backend streaming the dump into a flash partition.
+ *
+ * The dump is RLE compressed on the fly and written through stream_flash in
+ * CONFIG_COREDUMP_FLASH_STREAM_BUFFER_SIZE chunks, erasing pages only as they
+ * are reached. A header with the sizes, a checksum and the time spent in the
+ * fault handler is written at the start of the partition once the dump is
+ * complete, so a partially written dump is never reported as valid.
+ *
+ * COREDUMP_CMD_COPY_STORED_DUMP and COREDUMP_QUERY_GET_STORED_DUMP_SIZE give
+ * the decompressed dump, as expected by the coredump shell and other users of
+ * the coredump API. coredump_flash_read() gives the stored stream as is, which
+ * the mcumgr group uses to keep transfers short.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/debug/coredump.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/storage/stream_flash.h>
+#include <zephyr/sys/crc.h>
+
+#include "coredump_flash.h"
+
+#if !FIXED_PARTITION_EXISTS(coredump_partition)
+#error "The core dump flash backend needs a coredump_partition partition"
+#endif
+
+#define COREDUMP_PARTITION_ID FIXED_PARTITION_ID(coredump_partition)
+
+#define COREDUMP_FLASH_MAGIC	      0x43445a31 /* "CDZ1" */
+#define COREDUMP_FLASH_VERSION	      1
+#define COREDUMP_FLASH_FLAG_RLE	      BIT(0)
+
+/* Room reserved for the header, large enough for any write block size used by the DKs. */
+#define COREDUMP_FLASH_HDR_AREA	      64
+
+/* RLE stream: a control byte below 0x80 is followed by (control + 1) literal bytes,
+ * a control byte of 0x80 or above is followed by one byte repeated
+ * (control - 0x80 + RLE_RUN_MIN) times.
+ */
+#define RLE_LITERAL_MAX		      128
+#define RLE_RUN_MIN		      3
+#define RLE_RUN_MAX		      (RLE_RUN_MIN + 127)
+
+struct coredump_flash_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t flags;
+	uint16_t reserved;
+	uint32_t raw_size;
+	uint32_t stored_size;
+	uint32_t checksum;
+	uint32_t fault_us;
+	int32_t error;
+};
+
+BUILD_ASSERT(sizeof(struct coredump_flash_hdr) <= COREDUMP_FLASH_HDR_AREA);
+
+static struct {
+	const struct flash_area *fa;
+	struct stream_flash_ctx stream;
+	uint32_t start_cycles;
+	uint32_t raw_size;
+	uint32_t stored_size;
+	uint32_t checksum;
+	int error;
+
+	uint8_t literals[RLE_LITERAL_MAX];
+	size_t literal_len;
+	uint8_t run_byte;
+	size_t run_len;
+} ctx;
+
+static uint8_t stream_buf[CONFIG_COREDUMP_FLASH_STREAM_BUFFER_SIZE] __aligned(4);
+
+static void stored_write(const uint8_t *data, size_t len)
+{
+	int err;
+
+	if (ctx.error) {
+		return;
+	}
+
+	err = stream_flash_buffered_write(&ctx.stream, data, len, false);
+	if (err) {
+		ctx.error = err;
+		return;
+	}
+
+	ctx.checksum = crc32_ieee_update(ctx.checksum, data, len);
+	ctx.stored_size += len;
+}
+
+static void rle_flush_literals(void)
+{
+	uint8_t control;
+
+	if (ctx.literal_len == 0) {
+		return;
+	}
+
+	control = ctx.literal_len - 1;
+	stored_write(&control, 1);
+	stored_write(ctx.literals, ctx.literal_len);
+	ctx.literal_len = 0;
+}
+
+static void rle_flush_run(void)
+{
+	if (ctx.run_len >= RLE_RUN_MIN) {
+		uint8_t run[2] = { 0x80 | (ctx.run_len - RLE_RUN_MIN), ctx.run_byte };
+
+		rle_flush_literals();
+		stored_write(run, sizeof(run));
+	} else {
+		for (size_t i = 0; i < ctx.run_len; i++) {
+			ctx.literals[ctx.literal_len++] = ctx.run_byte;
+			if (ctx.literal_len == RLE_LITERAL_MAX) {
+				rle_flush_literals();
+			}
+		}
+	}
+
+	ctx.run_len = 0;
+}
+
+static void rle_put(uint8_t byte)
+{
+	if (ctx.run_len > 0 && byte == ctx.run_byte && ctx.run_len < RLE_RUN_MAX) {
+		ctx.run_len++;
+		return;
+	}
+
+	rle_flush_run();
+	ctx.run_byte = byte;
+	ctx.run_len = 1;
+}
+
+static int hdr_read(struct coredump_flash_hdr *hdr)
+{
+	const struct flash_area *fa;
+	int err;
+
+	err = flash_area_open(COREDUMP_PARTITION_ID, &fa);
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_read(fa, 0, hdr, sizeof(*hdr));
+	flash_area_close(fa);
+	if (err) {
+		return err;
+	}
+
+	if (hdr->magic != COREDUMP_FLASH_MAGIC || hdr->version != COREDUMP_FLASH_VERSION) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+static int stored_verify(void)
+{
+	struct coredump_flash_hdr hdr;
+	uint8_t buf[64];
+	uint32_t checksum = 0;
+	int err;
+
+	err = hdr_read(&hdr);
+	if (err) {
+		return err;
+	}
+
+	for (uint32_t off = 0; off < hdr.stored_size; off += sizeof(buf)) {
+		err = coredump_flash_read(off, buf, sizeof(buf));
+		if (err < 0) {
+			return err;
+		}
+		checksum = crc32_ieee_update(checksum, buf, err);
+	}
+
+	return (checksum == hdr.checksum) ? 0 : -EBADMSG;
+}
+
+/* Reader over the stored stream, refilled from flash in small blocks. */
+struct stored_reader {
+	uint32_t off;
+	uint8_t buf[64];
+	size_t len;
+	size_t pos;
+};
+
+static int stored_next(struct stored_reader *rd, uint8_t *byte)
+{
+	int ret;
+
+	if (rd->pos == rd->len) {
+		ret = coredump_flash_read(rd->off, rd->buf, sizeof(rd->buf));
+		if (ret <= 0) {
+			return (ret == 0) ? -EBADMSG : ret;
+		}
+		rd->off += ret;
+		rd->len = ret;
+		rd->pos = 0;
+	}
+
+	*byte = rd->buf[rd->pos++];
+
+	return 0;
+}
+
+/* Copy a part of the decompressed dump. The stream is decoded from its start on
+ * every call, as the RLE format has no index to seek with.
+ */
+static int raw_read(uint32_t offset, uint8_t *buf, size_t len)
+{
+	struct coredump_flash_hdr hdr;
+	struct stored_reader rd = { 0 };
+	uint32_t raw_off = 0;
+	size_t copied = 0;
+	uint8_t control;
+	uint8_t byte;
+	size_t count;
+	size_t skip;
+	int err;
+
+	err = hdr_read(&hdr);
+	if (err) {
+		return err;
+	}
+
+	if (!(hdr.flags & COREDUMP_FLASH_FLAG_RLE)) {
+		return coredump_flash_read(offset, buf, len);
+	}
+
+	if (offset >= hdr.raw_size) {
+		return 0;
+	}
+
+	len = MIN(len, hdr.raw_size - offset);
+
+	while (copied < len) {
+		err = stored_next(&rd, &control);
+		if (err) {
+			return err;
+		}
+
+		if (control < 0x80) {
+			for (count = control + 1; count > 0 && copied < len; count--) {
+				err = stored_next(&rd, &byte);
+				if (err) {
+					return err;
+				}
+				if (raw_off >= offset) {
+					buf[copied++] = byte;
+				}
+				raw_off++;
+			}
+			continue;
+		}
+
+		err = stored_next(&rd, &byte);
+		if (err) {
+			return err;
+		}
+
+		count = control - 0x80 + RLE_RUN_MIN;
+		skip = (raw_off < offset) ? MIN(count, offset - raw_off) : 0;
+		raw_off += skip;
+		count = MIN(count - skip, len - copied);
+		memset(&buf[copied], byte, count);
+		copied += count;
+		raw_off += count;
+	}
+
+	return copied;
+}
+
+/* Backend callbacks, called from the fault handler with interrupts locked. */
+
+static void coredump_flash_start(void)
+{
+	const struct device *fdev;
+	int err;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.start_cycles = k_cycle_get_32();
+
+	err = flash_area_open(COREDUMP_PARTITION_ID, &ctx.fa);
+	if (err) {
+		ctx.error = err;
+		return;
+	}
+
+	fdev = flash_area_get_device(ctx.fa);
+	err = stream_flash_init(&ctx.stream, fdev, stream_buf, sizeof(stream_buf),
+				ctx.fa->fa_off + COREDUMP_FLASH_HDR_AREA,
+				ctx.fa->fa_size - COREDUMP_FLASH_HDR_AREA, NULL);
+	if (err) {
+		ctx.error = err;
+	}
+}
+
+static void coredump_flash_buffer_output(uint8_t *buf, size_t buflen)
+{
+	ctx.raw_size += buflen;
+
+	if (!IS_ENABLED(CONFIG_COREDUMP_FLASH_STREAM_RLE)) {
+		stored_write(buf, buflen);
+		return;
+	}
+
+	for (size_t i = 0; i < buflen; i++) {
+		rle_put(buf[i]);
+	}
+}
+
+static void coredump_flash_end(void)
+{
+	uint8_t hdr_area[COREDUMP_FLASH_HDR_AREA] __aligned(4);
+	struct coredump_flash_hdr *hdr = (struct coredump_flash_hdr *)hdr_area;
+	int err;
+
+	if (IS_ENABLED(CONFIG_COREDUMP_FLASH_STREAM_RLE)) {
+		rle_flush_run();
+		rle_flush_literals();
+	}
+
+	if (!ctx.error) {
+		ctx.error = stream_flash_buffered_write(&ctx.stream, NULL, 0, true);
+	}
+
+	if (ctx.error) {
+		goto out;
+	}
+
+	memset(hdr_area, 0xff, sizeof(hdr_area));
+	hdr->magic = COREDUMP_FLASH_MAGIC;
+	hdr->version = COREDUMP_FLASH_VERSION;
+	hdr->flags = IS_ENABLED(CONFIG_COREDUMP_FLASH_STREAM_RLE) ? COREDUMP_FLASH_FLAG_RLE : 0;
+	hdr->reserved = 0;
+	hdr->raw_size = ctx.raw_size;
+	hdr->stored_size = ctx.stored_size;
+	hdr->checksum = ctx.checksum;
+	hdr->error = 0;
+	hdr->fault_us = k_cyc_to_us_floor32(k_cycle_get_32() - ctx.start_cycles);
+
+	err = flash_area_write(ctx.fa, 0, hdr_area, sizeof(hdr_area));
+	if (err) {
+		ctx.error = err;
+	}
+
+out:
+	flash_area_close(ctx.fa);
+}
+
+static int coredump_flash_query(enum coredump_query_id query_id, void *arg)
+{
+	struct coredump_flash_hdr hdr;
+	int err;
+
+	switch (query_id) {
+	case COREDUMP_QUERY_GET_ERROR:
+		return ctx.error;
+	case COREDUMP_QUERY_HAS_STORED_DUMP:
+		err = hdr_read(&hdr);
+		return (err == 0) ? 1 : ((err == -ENOENT) ? 0 : err);
+	case COREDUMP_QUERY_GET_STORED_DUMP_SIZE:
+		err = hdr_read(&hdr);
+		return (err == 0) ? hdr.raw_size : ((err == -ENOENT) ? 0 : err);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static int coredump_flash_cmd(enum coredump_cmd_id cmd_id, void *arg)
+{
+	struct coredump_cmd_copy_arg *copy_arg;
+
+	switch (cmd_id) {
+	case COREDUMP_CMD_CLEAR_ERROR:
+		ctx.error = 0;
+		return 0;
+	case COREDUMP_CMD_VERIFY_STORED_DUMP:
+		return (stored_verify() == 0) ? 1 : 0;
+	case COREDUMP_CMD_ERASE_STORED_DUMP:
+	case COREDUMP_CMD_INVALIDATE_STORED_DUMP:
+		return coredump_flash_erase();
+	case COREDUMP_CMD_COPY_STORED_DUMP:
+		copy_arg = arg;
+		if (copy_arg == NULL) {
+			return -EINVAL;
+		}
+		return raw_read(copy_arg->offset, copy_arg->buffer, copy_arg->length);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+struct coredump_backend_api coredump_backend_other = {
+	.start = coredump_flash_start,
+	.end = coredump_flash_end,
+	.buffer_output = coredump_flash_buffer_output,
+	.query = coredump_flash_query,
+	.cmd = coredump_flash_cmd,
+};
+
+/* Thread context API */
+
+int coredump_flash_info_get(struct coredump_flash_info *info)
+{
+	struct coredump_flash_hdr hdr;
+	int err;
+
+	err = hdr_read(&hdr);
+	if (err) {
+		return err;
+	}
+
+	info->raw_size = hdr.raw_size;
+	info->stored_size = hdr.stored_size;
+	info->fault_us = hdr.fault_us;
+	info->compressed = (hdr.flags & COREDUMP_FLASH_FLAG_RLE) != 0;
+
+	return 0;
+}
+
+int coredump_flash_read(uint32_t offset, uint8_t *buf, size_t len)
+{
+	const struct flash_area *fa;
+	struct coredump_flash_hdr hdr;
+	int err;
+
+	err = hdr_read(&hdr);
+	if (err) {
+		return err;
+	}
+
+	if (offset >= hdr.stored_size) {
+		return 0;
+	}
+
+	len = MIN(len, hdr.stored_size - offset);
+
+	err = flash_area_open(COREDUMP_PARTITION_ID, &fa);
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_read(fa, COREDUMP_FLASH_HDR_AREA + offset, buf, len);
+	flash_area_close(fa);
+
+	return err ? err : len;
+}
+
+int coredump_flash_erase(void)
+{
+	const struct flash_area *fa;
+	int err;
+
+	err = flash_area_open(COREDUMP_PARTITION_ID, &fa);
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_erase(fa, 0, fa->fa_size);
+	flash_area_close(fa);
+
+	return err;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef COREDUMP_FLASH_H_
+#define COREDUMP_FLASH_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Description of the core dump stored in the flash partition. */
+struct coredump_flash_info {
+	/* Size of the core dump as produced by the coredump subsystem. */
+	uint32_t raw_size;
+	/* Number of bytes stored in flash, after compression. */
+	uint32_t stored_size;
+	/* Time spent in the fault handler writing the dump, in microseconds. */
+	uint32_t fault_us;
+	/* True if the stored stream is RLE compressed. */
+	bool compressed;
+};
+
+/* @brief Get information about the stored core dump.
+ *
+ * @param[out] info Information about the stored core dump.
+ *
+ * @return 0 on success, -ENOENT if no valid dump is stored, otherwise a negative value.
+ */
+int coredump_flash_info_get(struct coredump_flash_info *info);
+
+/* @brief Read a part of the stored core dump stream.
+ *
+ * The stream is returned as stored in flash. When it is compressed, it must be
+ * decoded by the reader (see scripts/coredump_fetch.py); the coredump API
+ * returns the decompressed dump instead.
+ *
+ * @param[in]  offset Offset in the stored stream.
+ * @param[out] buf    Buffer the data is copied to.
+ * @param[in]  len    Size of the buffer.
+ *
+ * @return Number of bytes copied, 0 at the end of the stream, otherwise a negative value.
+ */
+int coredump_flash_read(uint32_t offset, uint8_t *buf, size_t len);
+
+/* @brief Erase the stored core dump.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int coredump_flash_erase(void);
+
+#endif /* COREDUMP_FLASH_H_ */
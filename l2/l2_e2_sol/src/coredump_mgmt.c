@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* mcumgr group used to retrieve the core dump stored by the flash backend.
+ *
+ * Command 0 (read):  information about the stored dump.
+ * Command 1 (read):  {"off": uint} returns {"off": uint, "data": bstr}.
+ * Command 1 (write): erases the stored dump.
+ *
+ * scripts/coredump_fetch.py implements the client side.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/mgmt/handlers.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <mgmt/mcumgr/util/zcbor_bulk.h>
+
+#include "coredump_flash.h"
+
+#define COREDUMP_MGMT_GROUP_ID	  (MGMT_GROUP_ID_PERUSER + 0)
+#define COREDUMP_MGMT_ID_INFO	  0
+#define COREDUMP_MGMT_ID_DATA	  1
+
+static int coredump_mgmt_info(struct smp_streamer *ctxt)
+{
+	zcbor_state_t *zse = ctxt->writer->zs;
+	struct coredump_flash_info info;
+	bool ok;
+	int err;
+
+	err = coredump_flash_info_get(&info);
+	if (err == -ENOENT) {
+		ok = zcbor_tstr_put_lit(zse, "present") && zcbor_bool_put(zse, false);
+		return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+	} else if (err) {
+		return MGMT_ERR_EUNKNOWN;
+	}
+
+	ok = zcbor_tstr_put_lit(zse, "present") && zcbor_bool_put(zse, true) &&
+	     zcbor_tstr_put_lit(zse, "raw") && zcbor_uint32_put(zse, info.raw_size) &&
+	     zcbor_tstr_put_lit(zse, "stored") && zcbor_uint32_put(zse, info.stored_size) &&
+	     zcbor_tstr_put_lit(zse, "rle") && zcbor_bool_put(zse, info.compressed) &&
+	     zcbor_tstr_put_lit(zse, "fault_us") && zcbor_uint32_put(zse, info.fault_us);
+
+	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+}
+
+static int coredump_mgmt_data_read(struct smp_streamer *ctxt)
+{
+	zcbor_state_t *zse = ctxt->writer->zs;
+	zcbor_state_t *zsd = ctxt->reader->zs;
+	uint8_t chunk[CONFIG_COREDUMP_FLASH_STREAM_MCUMGR_CHUNK_SIZE];
+	uint32_t off = 0;
+	size_t decoded;
+	bool ok;
+	int len;
+
+	struct zcbor_map_decode_key_val data_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_uint32_decode, &off),
+	};
+
+	if (zcbor_map_decode_bulk(zsd, data_decode, ARRAY_SIZE(data_decode), &decoded) != 0) {
+		return MGMT_ERR_EINVAL;
+	}
+
+	len = coredump_flash_read(off, chunk, sizeof(chunk));
+	if (len == -ENOENT) {
+		return MGMT_ERR_ENOENT;
+	} else if (len < 0) {
+		return MGMT_ERR_EUNKNOWN;
+	}
+
+	ok = zcbor_tstr_put_lit(zse, "off") && zcbor_uint32_put(zse, off) &&
+	     zcbor_tstr_put_lit(zse, "data") && zcbor_bstr_encode_ptr(zse, chunk, len);
+
+	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+}
+
+static int coredump_mgmt_data_erase(struct smp_streamer *ctxt)
+{
+	return coredump_flash_erase() ? MGMT_ERR_EUNKNOWN : MGMT_ERR_EOK;
+}
+
+static const struct mgmt_handler coredump_mgmt_handlers[] = {
+	[COREDUMP_MGMT_ID_INFO] = {
+		.mh_read = coredump_mgmt_info,
+		.mh_write = NULL,
+	},
+	[COREDUMP_MGMT_ID_DATA] = {
+		.mh_read = coredump_mgmt_data_read,
+		.mh_write = coredump_mgmt_data_erase,
+	},
+};
+
+static struct mgmt_group coredump_mgmt_group = {
+	.mg_handlers = coredump_mgmt_handlers,
+	.mg_handlers_count = ARRAY_SIZE(coredump_mgmt_handlers),
+	.mg_group_id = COREDUMP_MGMT_GROUP_ID,
+};
+
+static void coredump_mgmt_register_group(void)
+{
+	mgmt_register_group(&coredump_mgmt_group);
+}
+
+MCUMGR_HANDLER_DEFINE(coredump_mgmt, coredump_mgmt_register_group);
@@ -11,6 +11,10 @@
 /* STEP 1.2  - Include the header file for core dump */
 #include <zephyr/debug/coredump.h>
 
+#if defined(CONFIG_COREDUMP_FLASH_STREAM)
+#include "coredump_flash.h"
+#endif
+
 LOG_MODULE_REGISTER(Lesson2_Exercise2, LOG_LEVEL_INF);
 
 /* STEP 2.1 - Define crash_function to cause a fault error */
@@ -49,8 +53,33 @@ void button_handler(uint32_t button_state, uint32_t has_changed)
     }
 }
 
+#if defined(CONFIG_COREDUMP_FLASH_STREAM)
+static void coredump_report(void)
+{
+	struct coredump_flash_info info;
+	int err;
+
+	err = coredump_flash_info_get(&info);
+	if (err == -ENOENT) {
+		LOG_INF("No stored core dump");
+		return;
+	} else if (err) {
+		LOG_ERR("Failed to read the stored core dump, err %d", err);
+		return;
+	}
+
+	LOG_INF("Stored core dump: %u bytes, %u bytes in flash%s, written in %u us",
+		info.raw_size, info.stored_size, info.compressed ? " (RLE)" : "",
+		info.fault_us);
+}
+#endif
+
 int main(void)
 {
+#if defined(CONFIG_COREDUMP_FLASH_STREAM)
+	coredump_report();
+#endif
+
     if (dk_buttons_init(button_handler)) {
         LOG_ERR("Failed to initialize the buttons library");
     }
@@ -6,32 +6,42 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
-#include <dk_buttons_and_leds.h>
+#include <devacademy/button_engine.h>
 
 LOG_MODULE_REGISTER(Lesson2_Exercise3, LOG_LEVEL_INF);
 
-void button_handler(uint32_t button_state, uint32_t has_changed)
+static void button_event_handle(const struct button_event *evt)
 {
-	if (has_changed & button_state)
-	{
-		switch (has_changed)
-		{
-            case DK_BTN1_MSK:
-                LOG_INF("Button 1 pressed");
-                break;
-			default:
-				break;
+	switch (evt->type) {
+	case BUTTON_EVT_PRESS:
+		if (evt->buttons & BIT(0)) {
+			LOG_INF("Button 1 pressed");
 		}
-    }
+		break;
+	case BUTTON_EVT_LONG_PRESS:
+		LOG_INF("Button mask 0x%x long press", evt->buttons);
+		break;
+	case BUTTON_EVT_CHORD:
+		LOG_INF("Buttons 0x%x pressed together", evt->buttons);
+		break;
+	default:
+		break;
+	}
 }
 
 int main(void)
 {
-    if (dk_buttons_init(button_handler)) {
-        LOG_ERR("Failed to initialize the buttons library");
-    }
+	struct button_event events[8];
 
 	LOG_INF("Press button 1");
 
+	while (1) {
+		size_t count = button_engine_batch_get(events, ARRAY_SIZE(events), K_FOREVER);
+
+		for (size_t i = 0; i < count; i++) {
+			button_event_handle(&events[i]);
+		}
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -8,7 +8,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/pwm.h>
-#include <dk_buttons_and_leds.h>
+#include <devacademy/button_engine.h>
 
 LOG_MODULE_REGISTER(Lesson4_Exercise2, LOG_LEVEL_INF);
 
@@ -62,52 +62,94 @@ int set_led_blink(uint32_t period, uint32_t pulse_width_ns){
 }
 #endif
 
-void button_handler(uint32_t button_state, uint32_t has_changed)
+/* Outputs requested by a batch of button events. Only the last request of a burst
+ * is applied, and only if it differs from what the PWM channel already outputs.
+ */
+struct pwm_request {
+    uint32_t servo_pulse;
+#if DT_NODE_EXISTS(DT_NODELABEL(pwm_led0))
+    uint32_t led_period;
+    uint32_t led_pulse;
+#endif
+};
+
+static void button_events_reduce(const struct button_event *events, size_t count,
+                                 struct pwm_request *req)
 {
-    int err = 0;
-	if (has_changed & button_state)
-	{
-		switch (has_changed)
-		{
-            /* STEP 2.4 - Change motor angle when a button is pressed */
-            /* STEP 5.6 - Update the button handler with the new duty cycle */
-            case DK_BTN1_MSK:
-                LOG_INF("Button 1 pressed");
-                err = set_motor_angle(PWM_SERVO_MIN_PULSE_WIDTH);
-                break;
-            case DK_BTN2_MSK:
-                LOG_INF("Button 2 pressed");
-                err = set_motor_angle(PWM_SERVO_MAX_PULSE_WIDTH);
-                break;
-                
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].type != BUTTON_EVT_PRESS) {
+            continue;
+        }
+
+        /* STEP 2.4 - Change motor angle when a button is pressed */
+        /* STEP 5.6 - Update the button handler with the new duty cycle */
+        if (events[i].buttons & BIT(0)) {
+            LOG_INF("Button 1 pressed");
+            req->servo_pulse = PWM_SERVO_MIN_PULSE_WIDTH;
+        }
+        if (events[i].buttons & BIT(1)) {
+            LOG_INF("Button 2 pressed");
+            req->servo_pulse = PWM_SERVO_MAX_PULSE_WIDTH;
+        }
 #if DT_NODE_EXISTS(DT_NODELABEL(pwm_led0))
-            /* STEP 4.4 - Change LED when a button is pressed */
-            case DK_BTN3_MSK:
-                LOG_INF("Button 3 pressed");
-                err = set_led_blink(2*PWM_PERIOD, PWM_MIN_PULSE_WIDTH);
-                break;
-            case DK_BTN4_MSK:
-                LOG_INF("Button 4 pressed");
-                err = set_led_blink(4*PWM_PERIOD, PWM_MAX_PULSE_WIDTH);
-                break;
-#endif                
-			default:
-				break;
-		}
+        /* STEP 4.4 - Change LED when a button is pressed */
+        if (events[i].buttons & BIT(2)) {
+            LOG_INF("Button 3 pressed");
+            req->led_period = 2*PWM_PERIOD;
+            req->led_pulse = PWM_MIN_PULSE_WIDTH;
+        }
+        if (events[i].buttons & BIT(3)) {
+            LOG_INF("Button 4 pressed");
+            req->led_period = 4*PWM_PERIOD;
+            req->led_pulse = PWM_MAX_PULSE_WIDTH;
+        }
+#endif
+    }
+}
+
+static int pwm_request_apply(const struct pwm_request *req, struct pwm_request *applied)
+{
+    int ret = 0;
+    int err;
+
+    if (req->servo_pulse != applied->servo_pulse) {
+        err = set_motor_angle(req->servo_pulse);
         if (err) {
-            LOG_ERR("Error: couldn't set duty cycle, err %d", err);
+            LOG_ERR("Error: couldn't set the motor duty cycle, err %d", err);
+            ret = err;
+        } else {
+            applied->servo_pulse = req->servo_pulse;
         }
-	}
+    }
+
+#if DT_NODE_EXISTS(DT_NODELABEL(pwm_led0))
+    if (req->led_period != applied->led_period || req->led_pulse != applied->led_pulse) {
+        err = set_led_blink(req->led_period, req->led_pulse);
+        if (err) {
+            LOG_ERR("Error: couldn't set the LED duty cycle, err %d", err);
+            ret = ret ? ret : err;
+        } else {
+            applied->led_period = req->led_period;
+            applied->led_pulse = req->led_pulse;
+        }
+    }
+#endif
+
+    return ret;
 }
 
 int main(void)
 {
 
     int err = 0;
-        
-    if (dk_buttons_init(button_handler)) {
-        LOG_ERR("Failed to initialize the buttons library");
-    }
+    struct button_event events[8];
+    struct pwm_request applied = {
+        .servo_pulse = PWM_SERVO_MIN_PULSE_WIDTH,
+#if DT_NODE_EXISTS(DT_NODELABEL(pwm_led0))
+        .led_period = 2*PWM_PERIOD,
+        .led_pulse = PWM_MIN_PULSE_WIDTH,
+#endif
+    };
 
 #if DT_NODE_EXISTS(DT_NODELABEL(pwm_led0))
     /* STEP 2.3 - Check if the device is ready and set its initial value */
@@ -135,5 +177,17 @@ int main(void)
         return 0;
     }
 
+    /* Reprogram the PWM channels once per batch of button events, from thread context */
+    while (1) {
+        size_t count = button_engine_batch_get(events, ARRAY_SIZE(events), K_FOREVER);
+        struct pwm_request req = applied;
+
+        button_events_reduce(events, count, &req);
+        err = pwm_request_apply(&req, &applied);
+        if (err) {
+            LOG_WRN("PWM request not fully applied, err %d", err);
+        }
+    }
+
     return 0;
 }
@@ -7,6 +7,9 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include <devacademy/prof.h>
+#include <devacademy/trace_points.h>
+
 LOG_MODULE_REGISTER(Lesson6_Exercise3, LOG_LEVEL_DBG);
 
 /* STEP 2 - Include header for nrfx drivers */
@@ -95,23 +98,33 @@ static void saadc_event_handler(nrfx_saadc_evt_t const * p_event)
         case NRFX_SAADC_EVT_DONE:
 
             /* STEP 5.3 - Buffer has been filled. Do something with the data and proceed */
+            static uint32_t done_count;
+            TRACE_STAGE_BEGIN("saadc_process", done_count);
             int64_t average = 0;
             int16_t max = INT16_MIN;
             int16_t min = INT16_MAX;
             int16_t current_value; 
-            for(int i=0; i < p_event->data.done.size; i++){
-                current_value = ((int16_t *)(p_event->data.done.p_buffer))[i];
-                average += current_value;
-                if(current_value > max){
-                    max = current_value;
-                }
-                if(current_value < min){
-                    min = current_value;
+            {
+                PROF_SCOPE("saadc_loop");
+
+                for(int i=0; i < p_event->data.done.size; i++){
+                    current_value = ((int16_t *)(p_event->data.done.p_buffer))[i];
+                    average += current_value;
+                    if(current_value > max){
+                        max = current_value;
+                    }
+                    if(current_value < min){
+                        min = current_value;
+                    }
                 }
             }
             average = average/p_event->data.done.size;
+            TRACE_STAGE_END("saadc_process", done_count);
+            TRACE_STAGE_BEGIN("saadc_log", done_count);
             LOG_INF("SAADC buffer at 0x%x filled with %d samples", (uint32_t)p_event->data.done.p_buffer, p_event->data.done.size);
             LOG_INF("AVG=%d, MIN=%d, MAX=%d", (int16_t)average, min, max);
+            TRACE_STAGE_END("saadc_log", done_count);
+            done_count++;
             break;
         default:
             LOG_INF("Unhandled SAADC evt %d", p_event->type);
@@ -12,6 +12,8 @@
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/pm/device.h>
 #include <zephyr/pm/device_runtime.h>
+#include <devacademy/prof.h>
+#include <devacademy/trace_points.h>
 
 #define DT_DRV_COMPAT zephyr_custom_bme280
 
@@ -166,6 +168,7 @@ void bme280_compensate_temp(struct custom_bme280_data *data, int32_t adc_temp)
 
 void bme280_compensate_press(struct custom_bme280_data *data, int32_t adc_press)
 {
+    PROF_SCOPE("bme280_compensate_press");
     int64_t var1, var2, p;
 
     var1 = ((int64_t)data->t_fine) - 128000;
@@ -243,6 +246,7 @@ static int custom_bme280_sample_fetch(const struct device *dev,
 {
     struct custom_bme280_data *data = dev->data;
 
+    static uint32_t fetch_count;
     uint8_t buf[8];
     int32_t adc_press, adc_temp, adc_humidity;
     int size = 8;
@@ -250,6 +254,9 @@ static int custom_bme280_sample_fetch(const struct device *dev,
 
     __ASSERT_NO_MSG(chan == SENSOR_CHAN_ALL);
 
+    fetch_count++;
+    TRACE_STAGE_BEGIN("bme280_fetch", fetch_count);
+
     /* let power management system know that driver needs device to be active */
 
     if (IS_ENABLED(CONFIG_PM_DEVICE_RUNTIME))
@@ -267,6 +274,7 @@ static int custom_bme280_sample_fetch(const struct device *dev,
             /* let power management system know that device is no longer needed needed  */
             pm_device_runtime_put(dev);
         }
+        TRACE_STAGE_END("bme280_fetch", fetch_count);
         return err;
     }
 
@@ -279,6 +287,7 @@ static int custom_bme280_sample_fetch(const struct device *dev,
             /* let power management system know that device is no longer needed needed  */
             pm_device_runtime_put(dev);
         }
+        TRACE_STAGE_END("bme280_fetch", fetch_count);
         return err;
     }
 
@@ -288,9 +297,11 @@ static int custom_bme280_sample_fetch(const struct device *dev,
     adc_temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
     adc_humidity = (buf[6] << 8) | buf[7];
 
+    TRACE_STAGE_BEGIN("bme280_compensate", fetch_count);
     bme280_compensate_temp(data, adc_temp);
     bme280_compensate_press(data, adc_press);
     bme280_compensate_humidity(data, adc_humidity);
+    TRACE_STAGE_END("bme280_compensate", fetch_count);
 
     /* Check if device runtime power managemeng is enabled */
     if (IS_ENABLED(CONFIG_PM_DEVICE_RUNTIME))
@@ -300,6 +311,8 @@ static int custom_bme280_sample_fetch(const struct device *dev,
         pm_device_runtime_put(dev);
     }
 
+    TRACE_STAGE_END("bme280_fetch", fetch_count);
+
     return 0;
 }
 
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdbool.h>
+#include <devacademy/bench.h>
+#include <devacademy/prof.h>
+
+#include "kernels.h"
+
+/* Inputs of the largest step of the original workload */
+#define FIBONACCI_N       19
+#define PRIMES_LIMIT      500
+#define COLLATZ_N         200
+#define PERFECT_LIMIT     1000
+
+/* Inputs of the offload requests of l8_e2_sol */
+#define OFFLOAD_PRIMES_LIMIT  20000
+#define OFFLOAD_PERFECT_LIMIT 10000
+
+uint32_t fibonacci_naive(uint32_t n) {
+    uint32_t prev = 0, curr = 1, next;
+    for (uint32_t i = 2; i <= n; i++) {
+        next = prev + curr;
+        prev = curr;
+        curr = next;
+    }
+    return curr;
+}
+
+/** Check if a number is prime using trial division
+ *
+ * @param n Number to check for primality
+ * @return true if prime, false otherwise
+ */
+static bool is_prime(uint32_t n) {
+    if (n <= 1) return false;
+    for (uint32_t i = 2; i * i <= n; i++) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+
+uint32_t count_primes_naive(uint32_t limit) {
+    uint32_t count = 0;
+    for (uint32_t i = 2; i < limit; i++) {
+        if (is_prime(i)) count++;
+    }
+    return count;
+}
+
+uint32_t collatz_naive(uint32_t n) {
+    uint32_t steps = 0;
+    while (n != 1) {
+        n = (n % 2 == 0) ? (n / 2) : (3 * n + 1);
+        steps++;
+    }
+    return steps;
+}
+
+uint32_t perfect_numbers_naive(uint32_t limit) {
+    uint32_t count = 0;
+    for (uint32_t n = 2; n < limit; n++) {
+        uint32_t sum = 1;
+        for (uint32_t i = 2; i * i <= n; i++) {
+            if (n % i == 0) {
+                sum += i;
+                if (i != n / i) sum += n / i;
+            }
+        }
+        if (sum == n) count++;
+    }
+    return count;
+}
+
+#if defined(CONFIG_CUSTOM_IMAGE_KERNELS_FAST)
+#define KERNEL_IMPL(name) name##_fast
+#else
+#define KERNEL_IMPL(name) name##_naive
+#endif
+
+uint32_t calculate_fibonacci(uint32_t n) {
+    PROF_SCOPE("calculate_fibonacci");
+
+    return KERNEL_IMPL(fibonacci)(n);
+}
+
+uint32_t count_primes(uint32_t limit) {
+    return KERNEL_IMPL(count_primes)(limit);
+}
+
+uint32_t collatz_sequence(uint32_t n) {
+    return KERNEL_IMPL(collatz)(n);
+}
+
+uint32_t perfect_number_check(uint32_t limit) {
+    return KERNEL_IMPL(perfect_numbers)(limit);
+}
+
+/* Both implementations are benchmarked whichever one is selected, the checksums
+ * of a pair must match.
+ */
+BENCH_KERNEL_DEFINE(fibonacci_naive, fibonacci_naive, FIBONACCI_N);
+BENCH_KERNEL_DEFINE(fibonacci_fast, fibonacci_fast, FIBONACCI_N);
+BENCH_KERNEL_DEFINE(count_primes_naive, count_primes_naive, PRIMES_LIMIT);
+BENCH_KERNEL_DEFINE(count_primes_fast, count_primes_fast, PRIMES_LIMIT);
+BENCH_KERNEL_DEFINE(collatz_naive, collatz_naive, COLLATZ_N);
+BENCH_KERNEL_DEFINE(collatz_fast, collatz_fast, COLLATZ_N);
+BENCH_KERNEL_DEFINE(perfect_numbers_naive, perfect_numbers_naive, PERFECT_LIMIT);
+BENCH_KERNEL_DEFINE(perfect_numbers_fast, perfect_numbers_fast, PERFECT_LIMIT);
+BENCH_KERNEL_DEFINE(count_primes_offload_naive, count_primes_naive, OFFLOAD_PRIMES_LIMIT);
+BENCH_KERNEL_DEFINE(count_primes_offload_fast, count_primes_fast, OFFLOAD_PRIMES_LIMIT);
+BENCH_KERNEL_DEFINE(perfect_numbers_offload_naive, perfect_numbers_naive, OFFLOAD_PERFECT_LIMIT);
+BENCH_KERNEL_DEFINE(perfect_numbers_offload_fast, perfect_numbers_fast, OFFLOAD_PERFECT_LIMIT);
+
+#if defined(CONFIG_DEVACADEMY_PROF)
+/* The selected implementation through its probe, for the prof report */
+BENCH_KERNEL_DEFINE(calculate_fibonacci, calculate_fibonacci, FIBONACCI_N);
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef KERNELS_H_
+#define KERNELS_H_
+
+#include <zephyr/types.h>
+
+/** Calculate the nth number in the Fibonacci sequence iteratively
+ *
+ * @param n The position in the sequence to calculate
+ * @return The nth Fibonacci number
+ */
+uint32_t calculate_fibonacci(uint32_t n);
+
+/** Count all prime numbers up to a given limit
+ *
+ * @param limit Upper bound for prime counting
+ * @return Number of primes found
+ */
+uint32_t count_primes(uint32_t limit);
+
+/** Calculate steps in Collatz sequence until reaching 1
+ *
+ * @param n Starting number for sequence
+ * @return Number of steps to reach 1
+ */
+uint32_t collatz_sequence(uint32_t n);
+
+/** Find perfect numbers up to a given limit
+ * A perfect number equals the sum of its proper divisors
+ *
+ * @param limit Upper bound for checking perfect numbers
+ * @return Count of perfect numbers found
+ */
+uint32_t perfect_number_check(uint32_t limit);
+
+/* Implementations behind the functions above, selected with
+ * CONFIG_CUSTOM_IMAGE_KERNELS. Both are always built so that they can be
+ * benchmarked against each other, and return the same results.
+ */
+
+/** Fibonacci by iteration, O(n) */
+uint32_t fibonacci_naive(uint32_t n);
+
+/** Fibonacci by fast doubling, O(log n) */
+uint32_t fibonacci_fast(uint32_t n);
+
+/** Prime count by trial division of every integer */
+uint32_t count_primes_naive(uint32_t limit);
+
+/** Prime count with a segmented sieve of odd numbers, one bit per number */
+uint32_t count_primes_fast(uint32_t limit);
+
+/** Collatz steps by following the sequence */
+uint32_t collatz_naive(uint32_t n);
+
+/** Collatz steps with the results for small values cached */
+uint32_t collatz_fast(uint32_t n);
+
+/** Perfect numbers by factoring every integer */
+uint32_t perfect_numbers_naive(uint32_t limit);
+
+/** Perfect numbers with a segmented sieve of divisor sums */
+uint32_t perfect_numbers_fast(uint32_t limit);
+
+#endif /* KERNELS_H_ */
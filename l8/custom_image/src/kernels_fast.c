@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Faster implementations of the kernels in kernels.c, returning the same
+ * results. They keep their working memory in static buffers sized by
+ * Kconfig and are not reentrant: the image runs them from a single thread.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "kernels.h"
+
+/* Odd numbers only, one bit each: a segment covers 16 numbers per byte */
+#define SIEVE_BYTES       CONFIG_CUSTOM_IMAGE_KERNELS_SIEVE_SEGMENT
+#define SIEVE_SPAN        (SIEVE_BYTES * 16U)
+
+#define DIVISOR_SEGMENT   CONFIG_CUSTOM_IMAGE_KERNELS_DIVISOR_SEGMENT
+#define COLLATZ_CACHE     CONFIG_CUSTOM_IMAGE_KERNELS_COLLATZ_CACHE
+
+/* Composite flags of the odd numbers below SIEVE_SPAN, the base primes of every segment */
+static uint8_t sieve_base[SIEVE_BYTES];
+static bool sieve_base_ready;
+static uint8_t sieve_segment[SIEVE_BYTES];
+
+static uint32_t divisor_sums[DIVISOR_SEGMENT];
+
+/* Steps to reach 1, 0 when not known yet */
+static uint16_t collatz_cache[COLLATZ_CACHE];
+
+static inline void bit_set(uint8_t *bits, uint32_t i) {
+    bits[i / 8] |= BIT(i % 8);
+}
+
+static inline bool bit_get(const uint8_t *bits, uint32_t i) {
+    return (bits[i / 8] & BIT(i % 8)) != 0;
+}
+
+uint32_t fibonacci_fast(uint32_t n) {
+    /* F(2k) = F(k) * (2 * F(k + 1) - F(k)), F(2k + 1) = F(k)^2 + F(k + 1)^2,
+     * modulo 2^32 like the iterative version.
+     */
+    uint32_t a = 0, b = 1;
+
+    /* The iterative version returns 1 for n = 0 */
+    if (n == 0) return 1;
+
+    for (int bit = 31 - __builtin_clz(n); bit >= 0; bit--) {
+        uint32_t c = a * (2 * b - a);
+        uint32_t d = a * a + b * b;
+
+        if (n & BIT(bit)) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+static void sieve_base_init(void) {
+    memset(sieve_base, 0, sizeof(sieve_base));
+    bit_set(sieve_base, 0); /* 1 */
+
+    for (uint32_t p = 3; p * p < SIEVE_SPAN; p += 2) {
+        if (bit_get(sieve_base, p / 2)) continue;
+        for (uint32_t m = p * p; m < SIEVE_SPAN; m += 2 * p) {
+            bit_set(sieve_base, m / 2);
+        }
+    }
+    sieve_base_ready = true;
+}
+
+/** Count the bits cleared among the first @p count bits */
+static uint32_t bits_clear(const uint8_t *bits, uint32_t count) {
+    uint32_t set = 0;
+    uint32_t i;
+
+    for (i = 0; i < count / 8; i++) {
+        set += __builtin_popcount(bits[i]);
+    }
+    if (count % 8) {
+        set += __builtin_popcount(bits[i] & (BIT(count % 8) - 1));
+    }
+    return count - set;
+}
+
+uint32_t count_primes_fast(uint32_t limit) {
+    uint32_t count = 1; /* 2 */
+
+    if (limit <= 2) return 0;
+    /* The base primes of a segment come from the first one */
+    if ((uint64_t)limit > (uint64_t)SIEVE_SPAN * SIEVE_SPAN) return count_primes_naive(limit);
+
+    if (!sieve_base_ready) sieve_base_init();
+
+    for (uint32_t low = 0; low < limit; low += SIEVE_SPAN) {
+        uint32_t high = MIN((uint64_t)low + SIEVE_SPAN, limit);
+
+        if (low == 0) {
+            memcpy(sieve_segment, sieve_base, sizeof(sieve_segment));
+        } else {
+            memset(sieve_segment, 0, sizeof(sieve_segment));
+            for (uint32_t p = 3; p * p < high; p += 2) {
+                uint64_t m;
+
+                if (bit_get(sieve_base, p / 2)) continue;
+
+                /* First odd multiple of p in the segment */
+                m = MAX((uint64_t)p * p, (uint64_t)DIV_ROUND_UP(low, p) * p);
+                if ((m & 1) == 0) m += p;
+
+                for (; m < high; m += 2 * p) {
+                    bit_set(sieve_segment, (m - low) / 2);
+                }
+            }
+        }
+
+        /* Odd numbers low + 2i + 1 below high */
+        count += bits_clear(sieve_segment, (high - low) / 2);
+    }
+    return count;
+}
+
+uint32_t collatz_fast(uint32_t n) {
+    uint32_t steps = 0;
+    uint32_t x = n;
+
+    while (x != 1) {
+        if (x < COLLATZ_CACHE && collatz_cache[x] != 0) {
+            steps += collatz_cache[x];
+            break;
+        }
+        x = (x % 2 == 0) ? (x / 2) : (3 * x + 1);
+        steps++;
+    }
+
+    /* Walk the sequence again to fill the cache for the values seen */
+    for (uint32_t remaining = steps, y = n; y != 1 && remaining > 0; remaining--) {
+        if (y < COLLATZ_CACHE) {
+            if (collatz_cache[y] != 0) break;
+            collatz_cache[y] = remaining;
+        }
+        y = (y % 2 == 0) ? (y / 2) : (3 * y + 1);
+    }
+    return steps;
+}
+
+uint32_t perfect_numbers_fast(uint32_t limit) {
+    uint32_t count = 0;
+
+    for (uint32_t low = 2; low < limit; low += DIVISOR_SEGMENT) {
+        uint32_t high = MIN((uint64_t)low + DIVISOR_SEGMENT, limit);
+
+        /* Sum of the proper divisors, 1 divides every n >= 2 */
+        for (uint32_t i = 0; i < high - low; i++) {
+            divisor_sums[i] = 1;
+        }
+
+        /* Every divisor pair (d, q) with 2 <= d <= q and d * q = m, no division in the loop */
+        for (uint32_t d = 2; d * d < high; d++) {
+            uint32_t q = MAX(d, DIV_ROUND_UP(low, d));
+
+            for (uint32_t m = q * d; m < high; m += d, q++) {
+                divisor_sums[m - low] += (q != d) ? d + q : d;
+            }
+        }
+
+        for (uint32_t i = 0; i < high - low; i++) {
+            if (divisor_sums[i] == low + i) count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <devacademy/offload.h>
+
+#include "kernels.h"
+#include "offload_server.h"
+
+/* Requests are executed in the thread calling offload_server_run(),
+ * never in the IPC receive callback.
+ */
+K_MSGQ_DEFINE(request_queue, sizeof(struct offload_request), CONFIG_OFFLOAD_SERVER_QUEUE_SIZE, 4);
+
+static struct ipc_ept ep;
+static K_SEM_DEFINE(bound_sem, 0, 1);
+
+static void response_send(const struct offload_request *req, int status, uint32_t result,
+                          uint32_t exec_us)
+{
+    struct offload_response rsp = {
+        .id = req->id,
+        .status = status,
+        .result = result,
+        .exec_us = exec_us,
+    };
+    int err;
+
+    err = ipc_service_send(&ep, &rsp, sizeof(rsp));
+    if (err < 0) {
+        printk("Failed to send response %u: %d\n", req->id, err);
+    }
+}
+
+static void ep_bound(void *priv)
+{
+    k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+    struct offload_request req;
+
+    if (len != sizeof(req)) {
+        printk("Unexpected message of %u bytes\n", len);
+        return;
+    }
+
+    memcpy(&req, data, sizeof(req));
+
+    if (k_msgq_put(&request_queue, &req, K_NO_WAIT) != 0) {
+        response_send(&req, -EBUSY, 0, 0);
+    }
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+    .name = OFFLOAD_ENDPOINT_NAME,
+    .cb = {
+        .bound = ep_bound,
+        .received = ep_recv,
+    },
+};
+
+static int request_execute(const struct offload_request *req, uint32_t *result)
+{
+    switch (req->op) {
+    case OFFLOAD_OP_FIBONACCI:
+        *result = calculate_fibonacci(req->arg);
+        return 0;
+    case OFFLOAD_OP_COUNT_PRIMES:
+        *result = count_primes(req->arg);
+        return 0;
+    case OFFLOAD_OP_COLLATZ:
+        *result = collatz_sequence(req->arg);
+        return 0;
+    case OFFLOAD_OP_PERFECT_NUMBERS:
+        *result = perfect_number_check(req->arg);
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+void offload_server_run(void)
+{
+    const struct device *ipc0 = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+    struct offload_request req;
+    int err;
+
+    err = ipc_service_open_instance(ipc0);
+    if (err && err != -EALREADY) {
+        printk("ipc_service_open_instance() failed: %d\n", err);
+        return;
+    }
+
+    err = ipc_service_register_endpoint(ipc0, &ep, &ep_cfg);
+    if (err) {
+        printk("ipc_service_register_endpoint() failed: %d\n", err);
+        return;
+    }
+
+    k_sem_take(&bound_sem, K_FOREVER);
+    printk("Offload server ready\n");
+
+    while (1) {
+        uint32_t start, result = 0;
+        int status;
+
+        k_msgq_get(&request_queue, &req, K_FOREVER);
+
+        start = k_cycle_get_32();
+        status = request_execute(&req, &result);
+        response_send(&req, status, result, k_cyc_to_us_floor32(k_cycle_get_32() - start));
+    }
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef OFFLOAD_SERVER_H_
+#define OFFLOAD_SERVER_H_
+
+/** Serve offload requests from the application core
+ *
+ * Opens the ipc0 IPC service instance, then executes the requests one by one
+ * and sends back their results. Does not return unless the IPC setup fails.
+ */
+void offload_server_run(void);
+
+#endif /* OFFLOAD_SERVER_H_ */
@@ -6,9 +6,52 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
+#include "offload_client.h"
 #define LED0_NODE DT_ALIAS(led0)
 static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 
+#define PRIMES_LIMIT  20000
+#define PERFECT_LIMIT 10000
+
+#if defined(CONFIG_OFFLOAD_CLIENT)
+/* Called when the remote core has answered, the application core sleeps in between */
+static void offload_done(const struct offload_result *res, void *user_data)
+{
+	const char *name = user_data;
+
+	if (res->status) {
+		printk("Offload %s(%u) failed: %d\n", name, res->arg, res->status);
+		return;
+	}
+
+	printk("Offload %s(%u) = %u, latency %u us (remote execution %u us)\n", name, res->arg,
+	       res->result, res->latency_us, res->exec_us);
+}
+
+static void offload_work_submit(void)
+{
+	struct offload_stats stats;
+	int err;
+
+	err = offload_submit(OFFLOAD_OP_COUNT_PRIMES, PRIMES_LIMIT, offload_done,
+			     (void *)"count_primes");
+	if (err) {
+		printk("Failed to submit count_primes: %d\n", err);
+	}
+
+	err = offload_submit(OFFLOAD_OP_PERFECT_NUMBERS, PERFECT_LIMIT, offload_done,
+			     (void *)"perfect_number_check");
+	if (err) {
+		printk("Failed to submit perfect_number_check: %d\n", err);
+	}
+
+	offload_stats_get(&stats);
+	printk("Offload: %u completed, %u failed, %u in flight, latency min/avg/max %u/%u/%u us\n",
+	       stats.completed, stats.failed, stats.in_flight, stats.latency_min_us,
+	       stats.latency_avg_us, stats.latency_max_us);
+}
+#endif
+
 int main()
 {
 	int ret;
@@ -26,12 +69,25 @@ int main()
 	}
 	printk("This application is running on the Application Core (CPUAPP)\n");
 	printk("Hello from DevAcademy Intermediate, Lesson 8, Exercise 2\n");
+
+#if defined(CONFIG_OFFLOAD_CLIENT)
+	ret = offload_client_init(K_SECONDS(5));
+	if (ret) {
+		printk("Offload server not available: %d\n", ret);
+	}
+#endif
 	while (1) {
 
 		led_is_on = !led_is_on;
 		gpio_pin_toggle_dt(&led);
 		printk("LED status: %s\n", led_is_on ? "ON" : "OFF");
 
+#if defined(CONFIG_OFFLOAD_CLIENT)
+		if (ret == 0) {
+			offload_work_submit();
+		}
+#endif
+
 		k_sleep(K_MSEC(5000));
 	}
 
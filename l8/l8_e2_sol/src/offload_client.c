@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/logging/log.h>
+
+#include "offload_client.h"
+
+LOG_MODULE_REGISTER(offload_client, LOG_LEVEL_INF);
+
+/* A submitted request waiting for its response */
+struct in_flight {
+	bool used;
+	uint32_t id;
+	enum offload_op op;
+	uint32_t arg;
+	uint32_t start;
+	offload_done_cb cb;
+	void *user_data;
+};
+
+static struct in_flight table[CONFIG_OFFLOAD_CLIENT_MAX_IN_FLIGHT];
+static struct k_spinlock lock;
+static uint32_t next_id;
+static struct offload_stats stats;
+static uint64_t latency_sum_us;
+
+static struct ipc_ept ep;
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static bool connected;
+
+static void ep_bound(void *priv)
+{
+	connected = true;
+	k_sem_give(&bound_sem);
+}
+
+static void stats_update(const struct offload_result *res)
+{
+	if (res->status) {
+		stats.failed++;
+		return;
+	}
+
+	stats.latency_min_us = (stats.completed == 0) ? res->latency_us
+						      : MIN(stats.latency_min_us, res->latency_us);
+	stats.latency_max_us = MAX(stats.latency_max_us, res->latency_us);
+	latency_sum_us += res->latency_us;
+	stats.completed++;
+	stats.latency_avg_us = latency_sum_us / stats.completed;
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	struct offload_response rsp;
+	struct offload_result res;
+	offload_done_cb cb = NULL;
+	void *user_data = NULL;
+	k_spinlock_key_t key;
+	uint32_t end = k_cycle_get_32();
+
+	if (len != sizeof(rsp)) {
+		LOG_WRN("Unexpected message of %zu bytes", len);
+		return;
+	}
+
+	memcpy(&rsp, data, sizeof(rsp));
+
+	key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(table); i++) {
+		struct in_flight *req = &table[i];
+
+		if (!req->used || req->id != rsp.id) {
+			continue;
+		}
+
+		res.op = req->op;
+		res.arg = req->arg;
+		res.status = rsp.status;
+		res.result = rsp.result;
+		res.exec_us = rsp.exec_us;
+		res.latency_us = k_cyc_to_us_floor32(end - req->start);
+		cb = req->cb;
+		user_data = req->user_data;
+
+		req->used = false;
+		stats.in_flight--;
+		stats_update(&res);
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (cb == NULL) {
+		LOG_WRN("Response to unknown request %u", rsp.id);
+		return;
+	}
+
+	cb(&res, user_data);
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.name = OFFLOAD_ENDPOINT_NAME,
+	.cb = {
+		.bound = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+int offload_client_init(k_timeout_t timeout)
+{
+	const struct device *ipc0 = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+	int err;
+
+	err = ipc_service_open_instance(ipc0);
+	if (err && err != -EALREADY) {
+		LOG_ERR("ipc_service_open_instance() failed, err %d", err);
+		return err;
+	}
+
+	err = ipc_service_register_endpoint(ipc0, &ep, &ep_cfg);
+	if (err) {
+		LOG_ERR("ipc_service_register_endpoint() failed, err %d", err);
+		return err;
+	}
+
+	if (k_sem_take(&bound_sem, timeout)) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int offload_submit(enum offload_op op, uint32_t arg, offload_done_cb cb, void *user_data)
+{
+	struct offload_request req = {
+		.op = op,
+		.arg = arg,
+	};
+	struct in_flight *slot = NULL;
+	k_spinlock_key_t key;
+	int err;
+
+	if (!connected) {
+		return -ENOTCONN;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(table); i++) {
+		if (!table[i].used) {
+			slot = &table[i];
+			break;
+		}
+	}
+
+	if (slot == NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	req.id = next_id++;
+	slot->used = true;
+	slot->id = req.id;
+	slot->op = op;
+	slot->arg = arg;
+	slot->cb = cb;
+	slot->user_data = user_data;
+	slot->start = k_cycle_get_32();
+	stats.in_flight++;
+
+	k_spin_unlock(&lock, key);
+
+	err = ipc_service_send(&ep, &req, sizeof(req));
+	if (err < 0) {
+		key = k_spin_lock(&lock);
+		slot->used = false;
+		stats.in_flight--;
+		k_spin_unlock(&lock, key);
+		return err;
+	}
+
+	return 0;
+}
+
+void offload_stats_get(struct offload_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
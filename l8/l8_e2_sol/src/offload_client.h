@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef OFFLOAD_CLIENT_H_
+#define OFFLOAD_CLIENT_H_
+
+#include <zephyr/kernel.h>
+#include <devacademy/offload.h>
+
+/* Outcome of an offloaded request. */
+struct offload_result {
+	enum offload_op op;
+	uint32_t arg;
+	/* 0 on success, otherwise a negative error code from the server. */
+	int status;
+	uint32_t result;
+	/* Time from submission to the reception of the response, in microseconds. */
+	uint32_t latency_us;
+	/* Part of the latency spent executing on the remote core, in microseconds. */
+	uint32_t exec_us;
+};
+
+/* @brief Callback called when the response to a request arrives.
+ *
+ * Called from the IPC service receive context, so it must not block.
+ */
+typedef void (*offload_done_cb)(const struct offload_result *result, void *user_data);
+
+/* Latency statistics of the completed requests. */
+struct offload_stats {
+	uint32_t completed;
+	uint32_t failed;
+	uint32_t in_flight;
+	uint32_t latency_min_us;
+	uint32_t latency_max_us;
+	uint32_t latency_avg_us;
+};
+
+/* @brief Connect to the offload server on the remote core.
+ *
+ * @param[in] timeout Time to wait for the remote endpoint to be bound.
+ *
+ * @return 0 on success, -ETIMEDOUT if the remote core did not answer, otherwise a negative value.
+ */
+int offload_client_init(k_timeout_t timeout);
+
+/* @brief Submit a request to the remote core.
+ *
+ * @param[in] op        Operation to execute.
+ * @param[in] arg       Argument of the operation.
+ * @param[in] cb        Callback called with the result.
+ * @param[in] user_data Passed to the callback.
+ *
+ * @return 0 on success, -EBUSY if CONFIG_OFFLOAD_CLIENT_MAX_IN_FLIGHT requests are pending,
+ *         -ENOTCONN if the client is not connected, otherwise a negative value.
+ */
+int offload_submit(enum offload_op op, uint32_t arg, offload_done_cb cb, void *user_data);
+
+/* @brief Get the latency statistics. */
+void offload_stats_get(struct offload_stats *stats);
+
+#endif /* OFFLOAD_CLIENT_H_ */
@@ -1,8 +1,20 @@
 # Step 2.1 - Add external project as sysbuild image for the FLPR core or Network Core
-ExternalZephyrProject_Add(
-  APPLICATION custom_image_name
-  SOURCE_DIR ${APP_DIR}/../custom_image
-  BOARD nrf54l15dk/nrf54l15/cpuflpr
-  # BOARD nrf5340dk/nrf5340/cpunet
-  # BOARD nrf54lm20dk/nrf54lm20a/cpuflpr
-)
\ No newline at end of file
+# The offload service uses the ipc0 instance of each pair of cores
+if(SB_CONFIG_SOC STREQUAL "nrf5340")
+  set(custom_image_board nrf5340dk/nrf5340/cpunet)
+elseif(SB_CONFIG_SOC STREQUAL "nrf54l15")
+  set(custom_image_board nrf54l15dk/nrf54l15/cpuflpr)
+elseif(SB_CONFIG_SOC STREQUAL "nrf54lm20a")
+  set(custom_image_board nrf54lm20dk/nrf54lm20a/cpuflpr)
+endif()
+
+if(DEFINED custom_image_board)
+  ExternalZephyrProject_Add(
+    APPLICATION custom_image_name
+    SOURCE_DIR ${APP_DIR}/../custom_image
+    BOARD ${custom_image_board}
+  )
+
+  # Only submit offload requests when the server is built for the remote core
+  set_config_bool(${DEFAULT_IMAGE} CONFIG_OFFLOAD_CLIENT y)
+endif()
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SHM_BENCH_H_
+#define SHM_BENCH_H_
+
+#include <zephyr/types.h>
+
+/* Messages exchanged by the application and the remote image. Every message
+ * starts with this header, the rest of the payload is filler.
+ */
+enum shm_bench_type {
+	/* Echoed back with the same size. */
+	SHM_BENCH_PING = 1,
+	/* Released without reply. */
+	SHM_BENCH_DATA = 2,
+	/* Last message of a burst, answered by an ACK. */
+	SHM_BENCH_DATA_LAST = 3,
+	SHM_BENCH_ACK = 4,
+};
+
+struct shm_bench_msg {
+	uint32_t type;
+	uint32_t seq;
+};
+
+/* Messages per throughput measurement */
+#define SHM_BENCH_BURST 64
+
+#endif /* SHM_BENCH_H_ */
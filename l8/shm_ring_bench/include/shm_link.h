@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SHM_LINK_H_
+#define SHM_LINK_H_
+
+#include <stddef.h>
+#include <zephyr/kernel.h>
+
+/* Link to the other core over the pair of shared memory rings described by the
+ * shm_link devicetree node. Used by both the application and the remote image.
+ */
+
+/* @brief Initialize the transmit ring and attach to the receive ring.
+ *
+ * @param[in] timeout Time to wait for the other core to initialize its ring.
+ *
+ * @return 0 on success, -EAGAIN on timeout, otherwise a negative value.
+ */
+int shm_link_init(k_timeout_t timeout);
+
+/* @brief Claim space for a message in the transmit ring.
+ *
+ * Polls until the other core has released enough space.
+ *
+ * @param[in] len     Message size.
+ * @param[in] timeout Time to wait for space.
+ *
+ * @return Pointer to the message, written in place, NULL on timeout.
+ */
+void *shm_link_claim(size_t len, k_timeout_t timeout);
+
+/* @brief Send the claimed message, notifying the other core if its ring was empty. */
+void shm_link_send(size_t len);
+
+/* @brief Get the next received message.
+ *
+ * @param[out] len     Message size.
+ * @param[in]  timeout Time to wait for a message.
+ *
+ * @return Pointer to the message, read in place, NULL on timeout.
+ */
+const void *shm_link_recv(size_t *len, k_timeout_t timeout);
+
+/* @brief Release the message returned by shm_link_recv(). */
+void shm_link_release(void);
+
+#endif /* SHM_LINK_H_ */
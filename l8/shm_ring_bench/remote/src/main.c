@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Remote side of the shared memory ring benchmark: echoes PING messages with
+ * the same size, drops DATA messages and acknowledges the end of a burst.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "shm_bench.h"
+#include "shm_link.h"
+
+static void reply_send(uint32_t type, uint32_t seq, size_t size)
+{
+	struct shm_bench_msg *reply = shm_link_claim(size, K_FOREVER);
+
+	reply->type = type;
+	reply->seq = seq;
+	memset(reply + 1, (uint8_t)seq, size - sizeof(*reply));
+	shm_link_send(size);
+}
+
+int main(void)
+{
+	const struct shm_bench_msg *msg;
+	uint32_t type;
+	uint32_t seq;
+	size_t len;
+	int err;
+
+	err = shm_link_init(K_FOREVER);
+	if (err) {
+		printk("Shared memory link init failed (err %d)\n", err);
+		return 0;
+	}
+
+	printk("Shared memory ring benchmark remote on %s\n", CONFIG_BOARD_TARGET);
+
+	for (;;) {
+		msg = shm_link_recv(&len, K_FOREVER);
+		if (msg == NULL) {
+			continue;
+		}
+
+		type = (len >= sizeof(*msg)) ? msg->type : 0;
+		seq = (len >= sizeof(*msg)) ? msg->seq : 0;
+		/* Give the space back to the application before replying */
+		shm_link_release();
+
+		if (type == SHM_BENCH_PING) {
+			reply_send(SHM_BENCH_PING, seq, len);
+		} else if (type == SHM_BENCH_DATA_LAST) {
+			reply_send(SHM_BENCH_ACK, seq, sizeof(struct shm_bench_msg));
+		}
+	}
+
+	return 0;
+}
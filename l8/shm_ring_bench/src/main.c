@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Latency and throughput of the shared memory ring between the application
+ * core and the remote image, for payloads from 8 B to 4 KB.
+ *
+ * rtt_<size>:   one message echoed back by the remote core. The one-way
+ *               latency is reported as half of the round trip.
+ * burst_<size>: SHM_BENCH_BURST messages back to back, the last one
+ *               acknowledged by the remote core.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include <devacademy/bench.h>
+
+#include "shm_bench.h"
+#include "shm_link.h"
+
+#define SHM_BENCH_SIZES 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096
+#define SHM_BENCH_TIMEOUT K_MSEC(100)
+
+static const uint32_t sizes[] = { SHM_BENCH_SIZES };
+
+static uint32_t seq;
+static uint32_t errors;
+
+static bool msg_send(uint32_t type, uint32_t size)
+{
+	struct shm_bench_msg *msg = shm_link_claim(size, SHM_BENCH_TIMEOUT);
+
+	if (msg == NULL) {
+		errors++;
+		return false;
+	}
+
+	msg->type = type;
+	msg->seq = ++seq;
+	memset(msg + 1, (uint8_t)seq, size - sizeof(*msg));
+	shm_link_send(size);
+
+	return true;
+}
+
+/* Replies to requests that timed out arrive late, they are dropped until the
+ * reply to the last request so that one timeout does not shift every answer.
+ */
+static uint32_t reply_wait(uint32_t type)
+{
+	const struct shm_bench_msg *reply;
+	uint32_t reply_seq;
+	uint32_t reply_type;
+	size_t len;
+
+	do {
+		reply = shm_link_recv(&len, SHM_BENCH_TIMEOUT);
+		if (reply == NULL) {
+			errors++;
+			return 0;
+		}
+
+		reply_seq = (len >= sizeof(*reply)) ? reply->seq : 0;
+		reply_type = (len >= sizeof(*reply)) ? reply->type : 0;
+		shm_link_release();
+	} while (reply_seq != seq);
+
+	if (reply_type != type) {
+		errors++;
+	}
+
+	return reply_seq;
+}
+
+static uint32_t ring_rtt(uint32_t size)
+{
+	if (!msg_send(SHM_BENCH_PING, size)) {
+		return 0;
+	}
+
+	return reply_wait(SHM_BENCH_PING);
+}
+
+static uint32_t ring_burst(uint32_t size)
+{
+	for (int i = 0; i < SHM_BENCH_BURST; i++) {
+		if (!msg_send((i == SHM_BENCH_BURST - 1) ? SHM_BENCH_DATA_LAST : SHM_BENCH_DATA,
+			      size)) {
+			return 0;
+		}
+	}
+
+	return reply_wait(SHM_BENCH_ACK);
+}
+
+#define RTT_KERNEL(size)   BENCH_KERNEL_DEFINE(rtt_##size, ring_rtt, size)
+#define BURST_KERNEL(size) BENCH_KERNEL_DEFINE(burst_##size, ring_burst, size)
+
+FOR_EACH(RTT_KERNEL, (;), SHM_BENCH_SIZES);
+FOR_EACH(BURST_KERNEL, (;), SHM_BENCH_SIZES);
+
+static void report_print(void)
+{
+	char name[16];
+
+	printk("size,one_way_min_ns,one_way_median_ns,one_way_p99_ns,msgs_per_s,kbytes_per_s\n");
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		const struct bench_stats *rtt;
+		const struct bench_stats *burst;
+		uint64_t burst_ns;
+		uint64_t msgs_per_s;
+
+		snprintf(name, sizeof(name), "rtt_%u", sizes[i]);
+		rtt = bench_result_get(name);
+		snprintf(name, sizeof(name), "burst_%u", sizes[i]);
+		burst = bench_result_get(name);
+		if (rtt == NULL || burst == NULL) {
+			continue;
+		}
+
+		burst_ns = MAX(bench_cycles_to_ns(burst->median), 1);
+		msgs_per_s = ((uint64_t)SHM_BENCH_BURST * NSEC_PER_SEC) / burst_ns;
+
+		printk("%u,%llu,%llu,%llu,%llu,%llu\n", sizes[i],
+		       bench_cycles_to_ns(rtt->min) / 2, bench_cycles_to_ns(rtt->median) / 2,
+		       bench_cycles_to_ns(rtt->p99) / 2, msgs_per_s,
+		       (msgs_per_s * sizes[i]) / 1024);
+	}
+}
+
+int main(void)
+{
+	int err;
+
+	err = shm_link_init(K_SECONDS(5));
+	if (err) {
+		printk("Remote core not ready (err %d)\n", err);
+		return 0;
+	}
+
+	/* Wait for the remote core to serve its receive ring */
+	do {
+		errors = 0;
+		ring_rtt(sizeof(struct shm_bench_msg));
+	} while (errors != 0);
+
+	printk("Shared memory ring benchmark on %s\n", CONFIG_BOARD_TARGET);
+
+	err = bench_run_all();
+	if (err) {
+		return 0;
+	}
+
+	report_print();
+	printk("Errors: %u\n", errors);
+
+	if (errors == 0) {
+		printk("Shared memory ring test passed\n");
+	} else {
+		printk("Shared memory ring test FAILED\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/mbox.h>
+
+#include <devacademy/shm_ring.h>
+
+#include "shm_link.h"
+
+#define SHM_LINK_NODE	DT_NODELABEL(shm_link)
+#define SHM_LINK_MEM	DT_PHANDLE(SHM_LINK_NODE, memory_region)
+#define SHM_LINK_BASE	DT_REG_ADDR(SHM_LINK_MEM)
+#define SHM_LINK_RING	DT_PROP(SHM_LINK_NODE, ring_size)
+
+BUILD_ASSERT(DT_PROP(SHM_LINK_NODE, tx_offset) + SHM_LINK_RING <= DT_REG_SIZE(SHM_LINK_MEM) &&
+	     DT_PROP(SHM_LINK_NODE, rx_offset) + SHM_LINK_RING <= DT_REG_SIZE(SHM_LINK_MEM),
+	     "Rings do not fit in the shared memory region");
+
+static const struct mbox_dt_spec tx_mbox = MBOX_DT_SPEC_GET(SHM_LINK_NODE, tx);
+static const struct mbox_dt_spec rx_mbox = MBOX_DT_SPEC_GET(SHM_LINK_NODE, rx);
+
+static struct shm_ring tx_ring;
+static struct shm_ring rx_ring;
+
+/* Given by the other core when the receive ring goes from empty to non-empty */
+static K_SEM_DEFINE(rx_sem, 0, 1);
+
+static void rx_notify(const struct device *dev, mbox_channel_id_t channel_id, void *user_data,
+		      struct mbox_msg *data)
+{
+	k_sem_give(&rx_sem);
+}
+
+int shm_link_init(k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int err;
+
+	err = shm_ring_producer_init(&tx_ring,
+				     (void *)(SHM_LINK_BASE + DT_PROP(SHM_LINK_NODE, tx_offset)),
+				     SHM_LINK_RING);
+	if (err) {
+		return err;
+	}
+
+	err = mbox_register_callback_dt(&rx_mbox, rx_notify, NULL);
+	if (err) {
+		return err;
+	}
+
+	err = mbox_set_enabled_dt(&rx_mbox, true);
+	if (err) {
+		return err;
+	}
+
+	do {
+		err = shm_ring_consumer_init(&rx_ring,
+					     (void *)(SHM_LINK_BASE +
+						      DT_PROP(SHM_LINK_NODE, rx_offset)),
+					     SHM_LINK_RING);
+		if (err != -EAGAIN) {
+			return err;
+		}
+		k_sleep(K_MSEC(1));
+	} while (!sys_timepoint_expired(end));
+
+	return -EAGAIN;
+}
+
+void *shm_link_claim(size_t len, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	void *msg;
+
+	/* The consumer does not signal released space, poll for it */
+	while ((msg = shm_ring_claim(&tx_ring, len)) == NULL) {
+		if (len > shm_ring_max_payload(&tx_ring) || sys_timepoint_expired(end)) {
+			return NULL;
+		}
+		k_busy_wait(1);
+	}
+
+	return msg;
+}
+
+void shm_link_send(size_t len)
+{
+	if (shm_ring_commit(&tx_ring, len)) {
+		(void)mbox_send_dt(&tx_mbox, NULL);
+	}
+}
+
+const void *shm_link_recv(size_t *len, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	const void *msg;
+
+	/* Check the ring first, a notification is only sent when it was empty */
+	while ((msg = shm_ring_peek(&rx_ring, len)) == NULL) {
+		if (k_sem_take(&rx_sem, sys_timepoint_timeout(end)) != 0) {
+			return NULL;
+		}
+	}
+
+	return msg;
+}
+
+void shm_link_release(void)
+{
+	shm_ring_release(&rx_ring);
+}
@@ -0,0 +1,21 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+if("${SB_CONFIG_REMOTE_BOARD}" STREQUAL "")
+  message(FATAL_ERROR "Board ${BOARD} has no remote core supported by this sample")
+endif()
+
+ExternalZephyrProject_Add(
+  APPLICATION remote
+  SOURCE_DIR ${APP_DIR}/remote
+  BOARD ${SB_CONFIG_REMOTE_BOARD}
+)
+
+# On the simulated nRF5340 both cores run in one executable, built by the application image
+if(SB_CONFIG_BOARD_NRF5340BSIM_NRF5340_CPUAPP)
+  native_simulator_set_child_images(${DEFAULT_IMAGE} remote)
+endif()
+native_simulator_set_final_executable(${DEFAULT_IMAGE})
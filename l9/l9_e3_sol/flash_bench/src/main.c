@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Image upload into the secondary slot, directly and through flash_coalesce.
+ *
+ * Requests of CONFIG_FLASH_BENCH_CHUNK_SIZE arrive one after the other at the
+ * link rate, each once the previous one is written. They are gathered into
+ * blocks written as flash_img does with IMG_ERASE_PROGRESSIVELY: the sector a
+ * block ends in is erased first if it was not yet.
+ *
+ * The slot is on the flash simulator, with the erase and program times of an
+ * external NOR flash. Written directly, the upload waits for every erase and
+ * program. Through the devacademy,flash-coalesce device, announced the image
+ * as the DFU hook of the module does, they run while the next requests
+ * arrive. The per-phase times are printed for both.
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/printk.h>
+#include <devacademy/flash_coalesce.h>
+
+#define IMAGE_SIZE  CONFIG_FLASH_BENCH_IMAGE_SIZE
+#define CHUNK_SIZE  CONFIG_FLASH_BENCH_CHUNK_SIZE
+#define BLOCK_SIZE  CONFIG_FLASH_BENCH_BLOCK_SIZE
+#define SLOT_OFFSET FIXED_PARTITION_OFFSET(slot1_partition)
+
+BUILD_ASSERT(IMAGE_SIZE <= FIXED_PARTITION_SIZE(slot1_partition), "Image larger than the slot");
+
+static const struct device *const flash = FIXED_PARTITION_DEVICE(slot1_partition);
+static const struct device *const coalesce = DEVICE_DT_GET(DT_NODELABEL(flash_coalesce));
+
+struct run {
+	uint32_t total_ms;
+	uint32_t link_us;
+	/* Time the upload spent in flash calls */
+	uint32_t stall_us;
+	uint32_t erase_us;
+	uint32_t program_us;
+	uint32_t erases;
+	uint32_t programs;
+	uint32_t erases_ahead;
+};
+
+static uint8_t block[BLOCK_SIZE];
+
+static uint8_t image_byte(uint32_t off)
+{
+	return (off * 2654435761U) >> 24;
+}
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static int block_write(const struct device *dev, off_t addr, size_t len, off_t *erased_end,
+		       struct run *run)
+{
+	struct flash_pages_info info;
+	uint32_t start;
+	uint32_t us;
+	int err;
+
+	while (*erased_end < addr + (off_t)len) {
+		err = flash_get_page_info_by_offs(dev, *erased_end, &info);
+		if (err) {
+			return err;
+		}
+
+		start = k_cycle_get_32();
+		err = flash_erase(dev, info.start_offset, info.size);
+		us = elapsed_us(start);
+		if (err) {
+			printk("flash_erase at 0x%lx, error: %d\n", (long)info.start_offset, err);
+			return err;
+		}
+
+		run->stall_us += us;
+		run->erase_us += us;
+		run->erases++;
+		*erased_end = info.start_offset + info.size;
+	}
+
+	start = k_cycle_get_32();
+	err = flash_write(dev, addr, block, len);
+	us = elapsed_us(start);
+	if (err) {
+		printk("flash_write at 0x%lx, error: %d\n", (long)addr, err);
+		return err;
+	}
+
+	run->stall_us += us;
+	run->program_us += us;
+	run->programs++;
+
+	return 0;
+}
+
+static int upload(const char *label, const struct device *dev, struct run *run)
+{
+	struct flash_coalesce_stats stats;
+	off_t erased_end = SLOT_OFFSET;
+	uint32_t block_off = 0;
+	size_t fill = 0;
+	uint32_t start;
+	uint32_t us;
+	size_t n;
+	int err = 0;
+
+	*run = (struct run){ 0 };
+
+	if (dev == coalesce) {
+		flash_coalesce_stats_get(dev, &stats);
+		err = flash_coalesce_erase_ahead(dev, SLOT_OFFSET, IMAGE_SIZE);
+		if (err) {
+			printk("flash_coalesce_erase_ahead, error: %d\n", err);
+			return err;
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (uint32_t off = 0; off < IMAGE_SIZE && !err; off += n) {
+		n = MIN(CHUNK_SIZE, IMAGE_SIZE - off);
+
+		us = (uint32_t)((uint64_t)n * USEC_PER_SEC / CONFIG_FLASH_BENCH_LINK_RATE);
+		k_usleep(us);
+		run->link_us += us;
+
+		for (size_t i = 0; i < n && !err; i++) {
+			block[fill++] = image_byte(off + i);
+
+			if (fill == BLOCK_SIZE) {
+				err = block_write(dev, SLOT_OFFSET + block_off, fill, &erased_end,
+						  run);
+				block_off += fill;
+				fill = 0;
+			}
+		}
+	}
+
+	if (!err && fill > 0) {
+		err = block_write(dev, SLOT_OFFSET + block_off, fill, &erased_end, run);
+	}
+
+	/* The image is in flash once the pages in flight are programmed */
+	if (!err && dev == coalesce) {
+		uint32_t flush_start = k_cycle_get_32();
+
+		err = flash_coalesce_flush(dev);
+		run->stall_us += elapsed_us(flush_start);
+
+		flash_coalesce_stats_get(dev, &stats);
+		run->erase_us = stats.erase_us;
+		run->program_us = stats.program_us;
+		run->erases = stats.erases;
+		run->programs = stats.programs;
+		run->erases_ahead = stats.erases_ahead;
+	}
+
+	run->total_ms = elapsed_us(start) / USEC_PER_MSEC;
+
+	printk("%s: error %d, %u bytes in %u ms, %u B/s, link %u ms, upload stalled %u ms\n",
+	       label, err, IMAGE_SIZE, run->total_ms,
+	       run->total_ms ? (uint32_t)((uint64_t)IMAGE_SIZE * MSEC_PER_SEC / run->total_ms) : 0,
+	       run->link_us / USEC_PER_MSEC, run->stall_us / USEC_PER_MSEC);
+	printk("%s: %u erases in %u ms, %u programs in %u ms, %u erase requests served ahead\n",
+	       label, run->erases, run->erase_us / USEC_PER_MSEC, run->programs,
+	       run->program_us / USEC_PER_MSEC, run->erases_ahead);
+
+	return err;
+}
+
+/* Compare the slot, read from the flash itself, with the image */
+static int image_verify(void)
+{
+	uint8_t buf[256];
+	int err;
+
+	for (uint32_t off = 0; off < IMAGE_SIZE; off += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), IMAGE_SIZE - off);
+
+		err = flash_read(flash, SLOT_OFFSET + off, buf, len);
+		if (err) {
+			printk("flash_read, error: %d\n", err);
+			return err;
+		}
+
+		for (size_t i = 0; i < len; i++) {
+			if (buf[i] != image_byte(off + i)) {
+				printk("Image differs at offset %u\n", off + i);
+				return -EBADMSG;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	struct run direct;
+	struct run coalesced;
+	bool passed = true;
+
+	if (!device_is_ready(flash) || !device_is_ready(coalesce)) {
+		printk("Flash devices not ready\n");
+		return 0;
+	}
+
+	printk("Upload of %u bytes in %u byte requests at %u B/s, %u byte writes\n", IMAGE_SIZE,
+	       CHUNK_SIZE, CONFIG_FLASH_BENCH_LINK_RATE, BLOCK_SIZE);
+
+	passed &= upload("Direct", flash, &direct) == 0 && image_verify() == 0;
+	passed &= upload("Coalesced", coalesce, &coalesced) == 0 && image_verify() == 0;
+
+	printk("Coalesced upload in %u%% of the direct time\n",
+	       direct.total_ms ? coalesced.total_ms * 100 / direct.total_ms : 0);
+	passed &= coalesced.total_ms < direct.total_ms;
+
+	if (passed) {
+		printk("Flash write test passed\n");
+	} else {
+		printk("Flash write test FAILED\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env bash
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+# Upload an image to l9_e5_sol with the DFU throughput bench in BabbleSim.
+#
+# Builds l9_e5_sol for nrf52_bsim without MCUboot and with
+# overlay-dfu-fast.conf, and the bench, then runs both on one simulated
+# radio. Fails unless the bench prints "DFU throughput test passed".
+#
+# Needs ZEPHYR_BASE, BSIM_OUT_PATH and BSIM_COMPONENTS_PATH, as for the
+# Zephyr BabbleSim tests:
+#
+#   l9/l9_e5_sol/dfu_bench/run_bsim.sh [build directory]
+
+set -eu
+
+: "${ZEPHYR_BASE:?ZEPHYR_BASE is not set}"
+: "${BSIM_OUT_PATH:?BSIM_OUT_PATH is not set}"
+: "${BSIM_COMPONENTS_PATH:?BSIM_COMPONENTS_PATH is not set}"
+
+bench_dir=$(cd "$(dirname "$0")" && pwd)
+app_dir=$(dirname "$bench_dir")
+build_dir=$(realpath -m "${1:-build_dfu_bsim}")
+sim_id=dfu_bench_$$
+# 5 minutes of simulated time, the upload takes well under one
+sim_length=300e6
+
+west build -p -b nrf52_bsim -d "$build_dir/peripheral" --sysbuild "$app_dir" -- \
+	-DSB_CONFIG_BOOTLOADER_MCUBOOT=n -DEXTRA_CONF_FILE=overlay-dfu-fast.conf
+west build -p -b nrf52_bsim -d "$build_dir/central" --no-sysbuild "$bench_dir"
+
+peripheral_exe=$build_dir/peripheral/$(basename "$app_dir")/zephyr/zephyr.exe
+central_exe=$build_dir/central/zephyr/zephyr.exe
+log=$build_dir/central.log
+
+cd "$BSIM_OUT_PATH/bin"
+
+./bs_2G4_phy_v1 -s="$sim_id" -D=2 -sim_length="$sim_length" &
+phy=$!
+"$peripheral_exe" -s="$sim_id" -d=0 > "$build_dir/peripheral.log" 2>&1 &
+peripheral=$!
+"$central_exe" -s="$sim_id" -d=1 > "$log" 2>&1 || true
+
+wait "$peripheral" || true
+wait "$phy" || true
+
+cat "$log"
+
+if grep -q "DFU throughput test passed" "$log"; then
+	exit 0
+fi
+
+echo "DFU throughput test did not pass, peripheral log in $build_dir/peripheral.log" >&2
+exit 1
@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* SMP client uploading an image to l9_e5_sol over Bluetooth LE.
+ *
+ * Connects to the peripheral, exchanges the ATT MTU and sends image upload
+ * requests of the image management group one at a time, as the mcumgr
+ * clients of phones do. The throughput and the connection parameters the
+ * upload ended with are printed. Build l9_e5_sol with and without
+ * overlay-dfu-fast.conf to compare, the second with
+ * CONFIG_DFU_BENCH_EXPECT_FAST_MODE=n here.
+ *
+ * In BabbleSim, run_bsim.sh builds both for nrf52_bsim, l9_e5_sol with
+ * SB_CONFIG_BOOTLOADER_MCUBOOT=n and overlay-dfu-fast.conf, runs them on one
+ * simulated radio and checks the result. The bsim workflow of the repository
+ * runs it.
+ *
+ * The image is not a valid signed image, only its header is, so the
+ * peripheral takes the upload but never marks it for test.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+
+#define IMAGE_SIZE	CONFIG_DFU_BENCH_IMAGE_SIZE
+#define TIMEOUT		K_SECONDS(10)
+
+/* MCUboot image header, the image management group checks it on the first chunk */
+#define IMAGE_MAGIC	0x96f3b83d
+#define IMAGE_HDR_SIZE	0x200
+
+#define SMP_HDR_SIZE	8
+#define SMP_OP_WRITE	2
+#define SMP_VERSION_2	BIT(3)
+#define SMP_GROUP_IMAGE 1
+#define SMP_ID_UPLOAD	1
+/* Encoded keys and lengths of an upload request, at most */
+#define SMP_UPLOAD_OVERHEAD 48
+/* ATT header of the write */
+#define ATT_WRITE_OVERHEAD 3
+
+#define SMP_BUF_SIZE	(SMP_HDR_SIZE + SMP_UPLOAD_OVERHEAD + CONFIG_DFU_BENCH_CHUNK_SIZE)
+
+static struct bt_uuid_128 smp_char_uuid = BT_UUID_INIT_128(
+	BT_UUID_128_ENCODE(0xda2e7828, 0xfbce, 0x4e01, 0xae9e, 0x261174997c48));
+
+static struct bt_conn *conn;
+static uint16_t smp_handle;
+static K_SEM_DEFINE(step_sem, 0, 1);
+static int step_err;
+static atomic_t conn_lost;
+
+/* Response being reassembled from notifications */
+static uint8_t rsp_buf[128];
+static size_t rsp_len;
+static K_SEM_DEFINE(rsp_sem, 0, 1);
+
+static uint8_t image_byte(uint32_t offset)
+{
+	uint8_t hdr[16];
+
+	if (offset >= IMAGE_HDR_SIZE) {
+		return (offset * 2654435761U) >> 24;
+	} else if (offset >= sizeof(hdr)) {
+		/* The rest of the header is reserved */
+		return 0;
+	}
+
+	/* magic, load address, header size, protected TLV size, image size */
+	sys_put_le32(IMAGE_MAGIC, &hdr[0]);
+	sys_put_le32(0, &hdr[4]);
+	sys_put_le16(IMAGE_HDR_SIZE, &hdr[8]);
+	sys_put_le16(0, &hdr[10]);
+	sys_put_le32(IMAGE_SIZE - IMAGE_HDR_SIZE, &hdr[12]);
+
+	return hdr[offset];
+}
+
+static void step_done(int err)
+{
+	step_err = err;
+	k_sem_give(&step_sem);
+}
+
+static int step_wait(const char *label)
+{
+	if (k_sem_take(&step_sem, TIMEOUT)) {
+		printk("%s: timed out\n", label);
+		return -ETIMEDOUT;
+	}
+
+	if (step_err) {
+		printk("%s, error: %d\n", label, step_err);
+	}
+
+	return step_err;
+}
+
+static bool name_match(struct bt_data *data, void *user_data)
+{
+	bool *match = user_data;
+
+	if (data->type == BT_DATA_NAME_COMPLETE &&
+	    data->data_len == strlen(CONFIG_DFU_BENCH_PEER_NAME) &&
+	    memcmp(data->data, CONFIG_DFU_BENCH_PEER_NAME, data->data_len) == 0) {
+		*match = true;
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	bool match = false;
+	int err;
+
+	if (conn || type != BT_GAP_ADV_TYPE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(ad, name_match, &match);
+	if (!match || bt_le_scan_stop()) {
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BT_LE_CONN_PARAM_DEFAULT, &conn);
+	if (err) {
+		step_done(err);
+	}
+}
+
+static void connected(struct bt_conn *c, uint8_t err)
+{
+	step_done(err ? -ECONNREFUSED : 0);
+}
+
+static void disconnected(struct bt_conn *c, uint8_t reason)
+{
+	printk("Disconnected, reason 0x%02x\n", reason);
+	atomic_set(&conn_lost, 1);
+	step_done(-ENOTCONN);
+	k_sem_give(&rsp_sem);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void mtu_exchanged(struct bt_conn *c, uint8_t err, struct bt_gatt_exchange_params *params)
+{
+	step_done(err ? -EIO : 0);
+}
+
+static uint8_t smp_char_found(struct bt_conn *c, const struct bt_gatt_attr *attr,
+			      struct bt_gatt_discover_params *params)
+{
+	if (attr) {
+		smp_handle = ((struct bt_gatt_chrc *)attr->user_data)->value_handle;
+	}
+
+	step_done(smp_handle ? 0 : -ENOENT);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static uint8_t smp_notified(struct bt_conn *c, struct bt_gatt_subscribe_params *params,
+			    const void *data, uint16_t length)
+{
+	if (!data) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	length = MIN(length, sizeof(rsp_buf) - rsp_len);
+	memcpy(&rsp_buf[rsp_len], data, length);
+	rsp_len += length;
+
+	if (rsp_len >= SMP_HDR_SIZE && rsp_len >= SMP_HDR_SIZE + sys_get_be16(&rsp_buf[2])) {
+		k_sem_give(&rsp_sem);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void smp_subscribed(struct bt_conn *c, uint8_t err,
+			   struct bt_gatt_subscribe_params *params)
+{
+	step_done(err ? -EIO : 0);
+}
+
+static int smp_setup(void)
+{
+	static struct bt_gatt_exchange_params mtu_params = {
+		.func = mtu_exchanged,
+	};
+	static struct bt_gatt_discover_params disc_params = {
+		.uuid = &smp_char_uuid.uuid,
+		.func = smp_char_found,
+		.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+		.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+		.type = BT_GATT_DISCOVER_CHARACTERISTIC,
+	};
+	static struct bt_gatt_discover_params ccc_disc_params;
+	static struct bt_gatt_subscribe_params sub_params = {
+		.notify = smp_notified,
+		.subscribe = smp_subscribed,
+		.value = BT_GATT_CCC_NOTIFY,
+		.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+		.disc_params = &ccc_disc_params,
+	};
+	int err;
+
+	err = bt_gatt_exchange_mtu(conn, &mtu_params);
+	if (!err) {
+		err = step_wait("MTU exchange");
+	}
+	if (err) {
+		return err;
+	}
+
+	err = bt_gatt_discover(conn, &disc_params);
+	if (!err) {
+		err = step_wait("SMP characteristic discovery");
+	}
+	if (err) {
+		return err;
+	}
+
+	sub_params.value_handle = smp_handle;
+	err = bt_gatt_subscribe(conn, &sub_params);
+
+	return err ? err : step_wait("SMP subscription");
+}
+
+static int upload_request(uint8_t *buf, size_t size, uint8_t seq, uint32_t off, size_t len)
+{
+	uint8_t data[CONFIG_DFU_BENCH_CHUNK_SIZE];
+	zcbor_state_t zs[2];
+	bool ok;
+
+	for (size_t i = 0; i < len; i++) {
+		data[i] = image_byte(off + i);
+	}
+
+	zcbor_new_encode_state(zs, ARRAY_SIZE(zs), &buf[SMP_HDR_SIZE], size - SMP_HDR_SIZE, 0);
+
+	ok = zcbor_map_start_encode(zs, 4);
+	if (off == 0) {
+		ok = ok && zcbor_tstr_put_lit(zs, "image") && zcbor_uint32_put(zs, 0) &&
+		     zcbor_tstr_put_lit(zs, "len") && zcbor_uint32_put(zs, IMAGE_SIZE);
+	}
+	ok = ok && zcbor_tstr_put_lit(zs, "off") && zcbor_uint32_put(zs, off) &&
+	     zcbor_tstr_put_lit(zs, "data") && zcbor_bstr_encode_ptr(zs, data, len) &&
+	     zcbor_map_end_encode(zs, 4);
+	if (!ok) {
+		return -ENOMEM;
+	}
+
+	buf[0] = SMP_OP_WRITE | SMP_VERSION_2;
+	buf[1] = 0;
+	sys_put_be16(zs->payload - &buf[SMP_HDR_SIZE], &buf[2]);
+	sys_put_be16(SMP_GROUP_IMAGE, &buf[4]);
+	buf[6] = seq;
+	buf[7] = SMP_ID_UPLOAD;
+
+	return zs->payload - buf;
+}
+
+/* The "rc" of an SMP version 2 error, {"group": uint, "rc": int} */
+static bool error_decode(zcbor_state_t *zs, int32_t *rc)
+{
+	struct zcbor_string key;
+	bool ok;
+
+	if (!zcbor_map_start_decode(zs)) {
+		return false;
+	}
+
+	while (!zcbor_array_at_end(zs)) {
+		if (!zcbor_tstr_decode(zs, &key)) {
+			return false;
+		}
+
+		if (key.len == 2 && memcmp(key.value, "rc", 2) == 0) {
+			ok = zcbor_int32_decode(zs, rc);
+		} else {
+			ok = zcbor_any_skip(zs, NULL);
+		}
+		if (!ok) {
+			return false;
+		}
+	}
+
+	return zcbor_map_end_decode(zs);
+}
+
+/* The "off" of the upload response, or a negative error code */
+static int64_t upload_response(void)
+{
+	zcbor_state_t zs[3];
+	struct zcbor_string key;
+	uint32_t off = 0;
+	int32_t rc = 0;
+	int32_t err_rc = 0;
+	bool found = false;
+
+	zcbor_new_decode_state(zs, ARRAY_SIZE(zs), &rsp_buf[SMP_HDR_SIZE],
+			       rsp_len - SMP_HDR_SIZE, 1, NULL, 0);
+
+	if (!zcbor_map_start_decode(zs)) {
+		return -EBADMSG;
+	}
+
+	while (!zcbor_array_at_end(zs)) {
+		if (!zcbor_tstr_decode(zs, &key)) {
+			return -EBADMSG;
+		}
+
+		if (key.len == 3 && memcmp(key.value, "off", 3) == 0) {
+			found = zcbor_uint32_decode(zs, &off);
+		} else if (key.len == 2 && memcmp(key.value, "rc", 2) == 0) {
+			(void)zcbor_int32_decode(zs, &rc);
+		} else if (key.len == 3 && memcmp(key.value, "err", 3) == 0) {
+			if (!error_decode(zs, &err_rc)) {
+				return -EBADMSG;
+			}
+		} else if (!zcbor_any_skip(zs, NULL)) {
+			return -EBADMSG;
+		}
+	}
+
+	if (rc || err_rc) {
+		printk("Upload rejected, rc %d, group rc %d\n", rc, err_rc);
+		return -EIO;
+	}
+
+	return found ? off : -EBADMSG;
+}
+
+static int upload(void)
+{
+	static uint8_t buf[SMP_BUF_SIZE];
+	uint16_t mtu = bt_gatt_get_mtu(conn);
+	size_t chunk;
+	uint32_t off = 0;
+	uint32_t requests = 0;
+	int64_t start = k_uptime_get();
+	int64_t next;
+	int64_t ms;
+	int len;
+	int err;
+
+	/* Nothing is left for the data at the default MTU of 23 */
+	if (mtu <= ATT_WRITE_OVERHEAD + SMP_HDR_SIZE + SMP_UPLOAD_OVERHEAD) {
+		printk("MTU %u too small for an upload request\n", mtu);
+		return -EMSGSIZE;
+	}
+
+	chunk = MIN(CONFIG_DFU_BENCH_CHUNK_SIZE,
+		    mtu - ATT_WRITE_OVERHEAD - SMP_HDR_SIZE - SMP_UPLOAD_OVERHEAD);
+
+	printk("Uploading %u bytes, %zu per request, MTU %u\n", IMAGE_SIZE, chunk, mtu);
+
+	while (off < IMAGE_SIZE) {
+		len = upload_request(buf, sizeof(buf), requests, off,
+				     MIN(chunk, IMAGE_SIZE - off));
+		if (len < 0) {
+			return len;
+		}
+
+		rsp_len = 0;
+		k_sem_reset(&rsp_sem);
+
+		err = bt_gatt_write_without_response(conn, smp_handle, buf, len, false);
+		if (err) {
+			printk("bt_gatt_write_without_response, error: %d\n", err);
+			return err;
+		}
+
+		if (k_sem_take(&rsp_sem, TIMEOUT)) {
+			printk("No response at offset %u\n", off);
+			return -ETIMEDOUT;
+		}
+
+		/* Given by the disconnection as well, with no response */
+		if (atomic_get(&conn_lost) || rsp_len < SMP_HDR_SIZE) {
+			printk("Disconnected at offset %u\n", off);
+			return -ENOTCONN;
+		}
+
+		next = upload_response();
+		if (next < 0) {
+			return next;
+		}
+
+		off = next;
+		requests++;
+	}
+
+	ms = k_uptime_get() - start;
+	printk("Uploaded %u bytes in %u requests, %lld ms, %lld B/s\n", IMAGE_SIZE, requests, ms,
+	       ms ? (IMAGE_SIZE * 1000LL) / ms : 0);
+
+	return 0;
+}
+
+/* Connection parameters the upload ended with */
+static bool fast_mode_check(void)
+{
+	struct bt_conn_info info;
+
+	if (bt_conn_get_info(conn, &info)) {
+		return false;
+	}
+
+	printk("Connection: interval %u.%02u ms, latency %u, PHY %s, data length %u, MTU %u\n",
+	       info.le.interval * 125 / 100, info.le.interval * 125 % 100, info.le.latency,
+	       info.le.phy->tx_phy == BT_GAP_LE_PHY_2M ? "2M" : "1M",
+	       info.le.data_len->tx_max_len, bt_gatt_get_mtu(conn));
+
+	/* 15 ms */
+	return !IS_ENABLED(CONFIG_DFU_BENCH_EXPECT_FAST_MODE) ||
+	       (info.le.phy->tx_phy == BT_GAP_LE_PHY_2M && info.le.interval <= 12);
+}
+
+int main(void)
+{
+	bool passed;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return 0;
+	}
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (!err) {
+		err = step_wait("Connection to " CONFIG_DFU_BENCH_PEER_NAME);
+	}
+	if (!err) {
+		err = smp_setup();
+	}
+	if (!err) {
+		err = upload();
+	}
+
+	passed = (err == 0) && fast_mode_check();
+
+	if (passed) {
+		printk("DFU throughput test passed\n");
+	} else {
+		printk("DFU throughput test FAILED\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* DFU throughput mode.
+ *
+ * The first chunk of an image upload switches the connection to the 2M PHY,
+ * the longest data length, a larger ATT MTU and a short interval. Every
+ * chunk pushes back the return to the low power interval. The requests are
+ * made from the system work queue, the mcumgr callbacks run in the SMP work
+ * queue and only schedule them. Each of them holds its own reference to the
+ * connection, which can go away in the Bluetooth thread meanwhile.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/bluetooth/att.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+
+#include "dfu_fast.h"
+
+LOG_MODULE_REGISTER(dfu_fast, LOG_LEVEL_INF);
+
+/* Connection of the SMP client, and whether it is in DFU mode */
+static struct bt_conn *current_conn;
+static struct k_spinlock conn_lock;
+static bool fast;
+
+/* Image upload in progress, updated from the SMP work queue as each chunk
+ * is accepted
+ */
+static struct {
+	int64_t start_ms;
+	uint32_t size;
+	uint32_t bytes;
+} upload;
+
+static void fast_work_handler(struct k_work *work);
+static void idle_work_handler(struct k_work *work);
+static K_WORK_DEFINE(fast_work, fast_work_handler);
+static K_WORK_DELAYABLE_DEFINE(idle_work, idle_work_handler);
+
+static const char *phy_str(uint8_t phy)
+{
+	switch (phy) {
+	case BT_GAP_LE_PHY_1M:
+		return "1M";
+	case BT_GAP_LE_PHY_2M:
+		return "2M";
+	case BT_GAP_LE_PHY_CODED:
+		return "coded";
+	default:
+		return "?";
+	}
+}
+
+/* Reference to the connection of the SMP client, NULL if there is none */
+static struct bt_conn *conn_get(void)
+{
+	struct bt_conn *conn = NULL;
+
+	K_SPINLOCK(&conn_lock) {
+		if (current_conn) {
+			conn = bt_conn_ref(current_conn);
+		}
+	}
+
+	return conn;
+}
+
+static void conn_log(const char *label)
+{
+	struct bt_conn *conn = conn_get();
+	struct bt_conn_info info;
+
+	if (!conn) {
+		return;
+	}
+
+	if (!bt_conn_get_info(conn, &info)) {
+		LOG_INF("%s: interval %u.%02u ms, latency %u, PHY %s, data length %u, MTU %u",
+			label, info.le.interval * 125 / 100, info.le.interval * 125 % 100,
+			info.le.latency, phy_str(info.le.phy->tx_phy),
+			info.le.data_len->tx_max_len, bt_gatt_get_mtu(conn));
+	}
+
+	bt_conn_unref(conn);
+}
+
+#if defined(CONFIG_BT_GATT_CLIENT)
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	if (err) {
+		LOG_WRN("MTU exchange failed, err 0x%02x", err);
+	}
+}
+
+static struct bt_gatt_exchange_params mtu_params = {
+	.func = mtu_exchanged,
+};
+#endif
+
+static void fast_work_handler(struct k_work *work)
+{
+	struct bt_conn *conn;
+	int err;
+
+	if (fast) {
+		return;
+	}
+
+	conn = conn_get();
+	if (!conn) {
+		return;
+	}
+
+	fast = true;
+	LOG_INF("SMP client active, DFU throughput mode");
+
+	err = bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM_2M);
+	if (err) {
+		LOG_WRN("bt_conn_le_phy_update, error: %d", err);
+	}
+
+	err = bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+	if (err) {
+		LOG_WRN("bt_conn_le_data_len_update, error: %d", err);
+	}
+
+#if defined(CONFIG_BT_GATT_CLIENT)
+	/* Phones usually exchange the MTU themselves, only once per connection */
+	if (bt_gatt_get_mtu(conn) == BT_ATT_DEFAULT_LE_MTU) {
+		err = bt_gatt_exchange_mtu(conn, &mtu_params);
+		if (err) {
+			LOG_WRN("bt_gatt_exchange_mtu, error: %d", err);
+		}
+	}
+#endif
+
+	err = bt_conn_le_param_update(conn,
+				      BT_LE_CONN_PARAM(CONFIG_DFU_FAST_MODE_INTERVAL_MIN,
+						       CONFIG_DFU_FAST_MODE_INTERVAL_MAX, 0,
+						       CONFIG_DFU_FAST_MODE_TIMEOUT));
+	if (err) {
+		LOG_WRN("bt_conn_le_param_update, error: %d", err);
+	}
+
+	bt_conn_unref(conn);
+}
+
+static void idle_work_handler(struct k_work *work)
+{
+	struct bt_conn *conn;
+	int err;
+
+	if (!fast) {
+		return;
+	}
+
+	conn = conn_get();
+	if (!conn) {
+		return;
+	}
+
+	fast = false;
+	LOG_INF("SMP client idle, low power connection parameters");
+
+	/* The 2M PHY and the data length stay, they shorten every packet */
+	err = bt_conn_le_param_update(conn,
+				      BT_LE_CONN_PARAM(CONFIG_DFU_FAST_MODE_IDLE_INTERVAL_MIN,
+						       CONFIG_DFU_FAST_MODE_IDLE_INTERVAL_MAX,
+						       CONFIG_DFU_FAST_MODE_IDLE_LATENCY,
+						       CONFIG_DFU_FAST_MODE_TIMEOUT));
+	if (err) {
+		LOG_WRN("bt_conn_le_param_update, error: %d", err);
+	}
+
+	bt_conn_unref(conn);
+}
+
+static void upload_log(const char *result)
+{
+	uint32_t ms = k_uptime_get() - upload.start_ms;
+
+	LOG_INF("Upload %s: %u of %u bytes in %u ms, %u B/s", result, upload.bytes, upload.size,
+		ms, ms ? (uint32_t)((uint64_t)upload.bytes * MSEC_PER_SEC / ms) : 0);
+	conn_log("Upload");
+}
+
+static enum mgmt_cb_return img_cb(uint32_t event, enum mgmt_cb_return prev_status,
+				  int32_t *rc, uint16_t *group, bool *abort_more, void *data,
+				  size_t data_size)
+{
+	const struct img_mgmt_upload_check *check = data;
+
+	switch (event) {
+	case MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK:
+		k_work_submit(&fast_work);
+		k_work_reschedule(&idle_work, K_SECONDS(CONFIG_DFU_FAST_MODE_IDLE_SECONDS));
+
+		if (check->req->off == 0) {
+			upload.start_ms = k_uptime_get();
+			upload.size = check->req->size;
+			upload.bytes = 0;
+		}
+		upload.bytes += check->req->img_data.len;
+		break;
+	case MGMT_EVT_OP_IMG_MGMT_DFU_PENDING:
+		upload_log("done");
+		break;
+	case MGMT_EVT_OP_IMG_MGMT_DFU_STOPPED:
+		upload_log("stopped");
+		break;
+	default:
+		break;
+	}
+
+	return MGMT_CB_OK;
+}
+
+static struct mgmt_callback img_callback = {
+	.callback = img_cb,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK | MGMT_EVT_OP_IMG_MGMT_DFU_PENDING |
+		    MGMT_EVT_OP_IMG_MGMT_DFU_STOPPED,
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err || current_conn) {
+		return;
+	}
+
+	fast = false;
+
+	K_SPINLOCK(&conn_lock) {
+		current_conn = bt_conn_ref(conn);
+	}
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn != current_conn) {
+		return;
+	}
+
+	k_work_cancel(&fast_work);
+	k_work_cancel_delayable(&idle_work);
+
+	K_SPINLOCK(&conn_lock) {
+		current_conn = NULL;
+	}
+
+	bt_conn_unref(conn);
+}
+
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+			     uint16_t timeout)
+{
+	conn_log("Connection parameters updated");
+}
+
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	conn_log("PHY updated");
+}
+
+static void le_data_len_updated(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+	conn_log("Data length updated");
+}
+
+BT_CONN_CB_DEFINE(dfu_fast_conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+	.le_param_updated = le_param_updated,
+	.le_phy_updated = le_phy_updated,
+	.le_data_len_updated = le_data_len_updated,
+};
+
+int dfu_fast_init(void)
+{
+	mgmt_callback_register(&img_callback);
+
+	return 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DFU_FAST_H_
+#define DFU_FAST_H_
+
+#if defined(CONFIG_DFU_FAST_MODE)
+
+/* @brief Follow the image uploads to switch the connection
+ *	  parameters, and log the throughput of each upload.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int dfu_fast_init(void);
+
+#else
+
+static inline int dfu_fast_init(void)
+{
+	return 0;
+}
+
+#endif /* CONFIG_DFU_FAST_MODE */
+
+#endif /* DFU_FAST_H_ */
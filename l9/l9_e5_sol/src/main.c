@@ -25,6 +25,9 @@
 #include <zephyr/settings/settings.h>
 
 #include <dk_buttons_and_leds.h>
+#include <devacademy/button_engine.h>
+
+#include "dfu_fast.h"
 
 #define DEVICE_NAME             CONFIG_BT_DEVICE_NAME
 #define DEVICE_NAME_LEN         (sizeof(DEVICE_NAME) - 1)
@@ -38,6 +41,9 @@
 
 #define USER_BUTTON             DK_BTN1_MSK
 
+#define BUTTON_THREAD_STACKSIZE 1024
+#define BUTTON_THREAD_PRIORITY  7
+
 static bool app_button_state;
 static struct k_work adv_work;
 
@@ -185,28 +191,35 @@ static struct bt_lbs_cb lbs_callbacs = {
 	.button_cb = app_button_cb,
 };
 
-static void button_changed(uint32_t button_state, uint32_t has_changed)
+/* Notify the button state once per batch of button events, and only if it changed */
+static void button_thread(void *unused1, void *unused2, void *unused3)
 {
-	if (has_changed & USER_BUTTON) {
-		uint32_t user_button_state = button_state & USER_BUTTON;
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
 
-		bt_lbs_send_button_state(user_button_state);
-		app_button_state = user_button_state ? true : false;
-	}
-}
+	struct button_event events[8];
 
-static int init_button(void)
-{
-	int err;
+	while (1) {
+		size_t count = button_engine_batch_get(events, ARRAY_SIZE(events), K_FOREVER);
+		bool user_button_state = app_button_state;
 
-	err = dk_buttons_init(button_changed);
-	if (err) {
-		printk("Cannot init buttons (err: %d)\n", err);
-	}
+		for (size_t i = 0; i < count; i++) {
+			if (events[i].buttons & USER_BUTTON) {
+				user_button_state = (events[i].state & USER_BUTTON) != 0;
+			}
+		}
 
-	return err;
+		if (user_button_state != app_button_state) {
+			app_button_state = user_button_state;
+			bt_lbs_send_button_state(user_button_state);
+		}
+	}
 }
 
+K_THREAD_DEFINE(button_thread_id, BUTTON_THREAD_STACKSIZE, button_thread, NULL, NULL, NULL,
+		BUTTON_THREAD_PRIORITY, 0, 0);
+
 int main(void)
 {
 	int blink_status = 0;
@@ -220,12 +233,6 @@ int main(void)
 		return 0;
 	}
 
-	err = init_button();
-	if (err) {
-		printk("Button init failed (err %d)\n", err);
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_BT_LBS_SECURITY_ENABLED)) {
 		err = bt_conn_auth_cb_register(&conn_auth_callbacks);
 		if (err) {
@@ -258,6 +265,12 @@ int main(void)
 		return 0;
 	}
 
+	err = dfu_fast_init();
+	if (err) {
+		printk("DFU throughput mode init failed (err %d)\n", err);
+		return 0;
+	}
+
 	k_work_init(&adv_work, adv_work_handler);
 	advertising_start();
 
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Write the images and the patch of the delta run of the benchmark.
+
+old.bin stands in for the image in the primary slot, new.bin for a release
+changing a few percent of it: scattered edits, a function added and one
+removed. patch.bin is made by scripts/delta_diff.py.
+"""
+
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "..", "..", "scripts"))
+from delta_diff import make_patch  # noqa: E402
+
+
+def main():
+    out_dir, size = sys.argv[1], int(sys.argv[2])
+    rng = random.Random(2026)
+
+    old = bytes(rng.getrandbits(8) for _ in range(size))
+
+    new = bytearray(old)
+    for _ in range(size // 512):
+        pos = rng.randrange(size - 64)
+        length = rng.randrange(1, 32)
+        new[pos:pos + length] = bytes(rng.getrandbits(8) for _ in range(length))
+    pos = size // 3
+    new[pos:pos] = bytes(rng.getrandbits(8) for _ in range(4096))
+    pos = 2 * size // 3
+    del new[pos:pos + 2048]
+    new = bytes(new)
+
+    patch = make_patch(old, new)
+
+    for name, data in (("old", old), ("new", new), ("patch", patch)):
+        with open(os.path.join(out_dir, f"{name}.bin"), "wb") as f:
+            f.write(data)
+
+
+if __name__ == "__main__":
+    main()
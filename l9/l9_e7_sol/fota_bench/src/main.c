@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Download pipeline of l9_e7_sol against an image server stand-in.
+ *
+ * The image is downloaded once without interruption, then again with the
+ * connection dropping part way. The checkpoint is reloaded from settings as
+ * after a reboot and the download resumed. The slot must hold the image after
+ * both, with little fetched twice.
+ *
+ * Compare the throughput with CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_BUFFERS=1,
+ * where the fetch and the flash write run in turn.
+ *
+ * With CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA, a patch made at build time
+ * by scripts/delta_diff.py is then applied to an image written to the
+ * primary slot, and the transfer compared with the full download.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "fota_pipeline.h"
+#include "server.h"
+
+#define IMAGE_SIZE	CONFIG_FOTA_BENCH_IMAGE_SIZE
+#define IMAGE_URL	"http://images.example.com/app_update.bin"
+#define PATCH_URL	"http://images.example.com/app_update.delta"
+#define DONE_TIMEOUT	K_SECONDS(600)
+
+/* Fetched again on a resume: the chunks past the checkpoint and the page it starts in */
+#define REFETCH_MAX	(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_CHECKPOINT_BYTES + 4096 + \
+			 CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_BUFFERS *		 \
+			 CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_CHUNK_SIZE)
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static int done_err;
+
+static void on_done(int err)
+{
+	done_err = err;
+	k_sem_give(&done_sem);
+}
+
+static int download(const char *label, const char *url, uint32_t size,
+		    struct fota_pipeline_stats *stats)
+{
+	int err;
+
+	err = fota_pipeline_start(url, size, server_fetch, NULL);
+	if (err) {
+		printk("fota_pipeline_start, error: %d\n", err);
+		return err;
+	}
+
+	if (k_sem_take(&done_sem, DONE_TIMEOUT)) {
+		printk("%s: timed out\n", label);
+		return -ETIMEDOUT;
+	}
+
+	fota_pipeline_stats_get(stats);
+
+	printk("%s: error %d, from %u, %u bytes fetched, %u written in %u ms, %u B/s\n", label,
+	       done_err, stats->resumed_from, stats->fetched, stats->written, stats->elapsed_ms,
+	       stats->elapsed_ms ? (uint32_t)((uint64_t)stats->fetched * MSEC_PER_SEC /
+					      stats->elapsed_ms) : 0);
+	printk("%s: fetch %u ms, write %u ms, fetcher idle %u ms, writer idle %u ms, "
+	       "checkpoints %u\n", label, stats->fetch_ms, stats->write_ms, stats->fetch_idle_ms,
+	       stats->write_idle_ms, stats->checkpoints);
+
+	return done_err;
+}
+
+/* Compare the secondary slot with image, or with the generated image if NULL */
+static int image_verify(const uint8_t *image, size_t size)
+{
+	const struct flash_area *fa;
+	uint8_t buf[256];
+	int err;
+
+	err = flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa);
+	if (err) {
+		return err;
+	}
+
+	for (uint32_t off = 0; off < size && !err; off += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), size - off);
+
+		err = flash_area_read(fa, off, buf, len);
+		for (size_t i = 0; i < len && !err; i++) {
+			if (buf[i] != (image ? image[off + i] : server_image_byte(off + i))) {
+				printk("Image differs at offset %u\n", off + i);
+				err = -EBADMSG;
+			}
+		}
+	}
+
+	flash_area_close(fa);
+
+	return err;
+}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+static const uint8_t old_image[] = {
+#include "delta_old.inc"
+};
+
+static const uint8_t new_image[] = {
+#include "delta_new.inc"
+};
+
+static const uint8_t patch[] = {
+#include "delta_patch.inc"
+};
+
+static int primary_slot_write(const uint8_t *image, size_t size)
+{
+	const struct flash_area *fa;
+	int err;
+
+	err = flash_area_open(FIXED_PARTITION_ID(slot0_partition), &fa);
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_erase(fa, 0, ROUND_UP(size, 4096));
+	if (!err) {
+		err = flash_area_write(fa, 0, image, size);
+	}
+
+	flash_area_close(fa);
+
+	return err;
+}
+
+/* The new image rebuilt from the primary slot and a patch, against the full download */
+static int delta_run(const struct fota_pipeline_stats *full)
+{
+	struct fota_pipeline_stats delta;
+	char id[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+	uint32_t size;
+	uint32_t offset;
+	int err;
+
+	err = primary_slot_write(old_image, sizeof(old_image));
+	if (err) {
+		printk("Primary slot write, error: %d\n", err);
+		return err;
+	}
+
+	server_file_set(patch, sizeof(patch));
+
+	/* An interrupted patch leaves no checkpoint to resume */
+	server_interrupt_at(sizeof(patch) / 2);
+	err = download("delta interrupted", PATCH_URL, sizeof(patch), &delta);
+	if (err != -ECONNRESET ||
+	    fota_pipeline_pending(id, sizeof(id), &size, &offset) != -ENOENT) {
+		printk("Interrupted patch: error %d, checkpoint kept\n", err);
+		server_file_set(NULL, 0);
+		return -EBADMSG;
+	}
+
+	err = download("delta", PATCH_URL, sizeof(patch), &delta);
+	server_file_set(NULL, 0);
+	if (err) {
+		return err;
+	}
+
+	err = image_verify(new_image, sizeof(new_image));
+	if (err) {
+		return err;
+	}
+
+	printk("Delta: patch of %zu bytes for a %zu byte image, %u%% of the transfer, "
+	       "%u ms against %u ms for the full image\n", sizeof(patch), sizeof(new_image),
+	       (uint32_t)(100 * sizeof(patch) / sizeof(new_image)), delta.elapsed_ms,
+	       full->elapsed_ms);
+
+	return (delta.written == sizeof(new_image)) ? 0 : -EBADMSG;
+}
+#endif /* CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA */
+
+int main(void)
+{
+	struct fota_pipeline_stats full;
+	struct fota_pipeline_stats cut;
+	struct fota_pipeline_stats resumed;
+	struct server_stats server;
+	char id[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+	uint32_t size = 0;
+	uint32_t offset = 0;
+	uint32_t refetched;
+	bool passed = true;
+	int err;
+
+	err = fota_pipeline_init(on_done);
+	if (!err) {
+		err = fota_pipeline_clear();
+	}
+	if (err) {
+		printk("FOTA pipeline init, error: %d\n", err);
+		return 0;
+	}
+
+	/* Uninterrupted download */
+	err = download("full", IMAGE_URL, IMAGE_SIZE, &full);
+	passed &= (err == 0) && image_verify(NULL, IMAGE_SIZE) == 0;
+	passed &= fota_pipeline_start(IMAGE_URL, IMAGE_SIZE, server_fetch, NULL) == -EALREADY;
+
+	/* Interrupted download, resumed from the checkpoint loaded again as after a reboot */
+	(void)fota_pipeline_clear();
+	server_interrupt_at(IMAGE_SIZE / 100 * CONFIG_FOTA_BENCH_INTERRUPT_PERCENT);
+	err = download("interrupted", IMAGE_URL, IMAGE_SIZE, &cut);
+	passed &= (err == -ECONNRESET);
+
+	/* The RAM state is reset, the checkpoint can only come back from NVS */
+	err = fota_pipeline_init(on_done);
+	if (!err) {
+		err = fota_pipeline_pending(id, sizeof(id), &size, &offset);
+	}
+	printk("Checkpoint after reboot: error %d, offset %u of %u\n", err, offset, size);
+	passed &= (err == 0) && offset > 0 && offset < IMAGE_SIZE && size == IMAGE_SIZE &&
+		  strcmp(id, IMAGE_URL) == 0;
+
+	err = download("resumed", IMAGE_URL, IMAGE_SIZE, &resumed);
+	passed &= (err == 0) && resumed.resumed_from == offset && image_verify(NULL, IMAGE_SIZE) == 0;
+
+	refetched = cut.fetched + resumed.fetched - IMAGE_SIZE;
+	server_stats_get(&server);
+	printk("Resume: %u bytes fetched twice, at most %u expected\n", refetched, REFETCH_MAX);
+	printk("server: requests %u bytes %u interruptions %u\n", server.requests, server.bytes,
+	       server.interruptions);
+	passed &= refetched <= REFETCH_MAX;
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+	passed &= delta_run(&full) == 0;
+#endif
+
+	if (passed) {
+		printk("FOTA pipeline test passed\n");
+	} else {
+		printk("FOTA pipeline test FAILED\n");
+	}
+
+	return 0;
+}
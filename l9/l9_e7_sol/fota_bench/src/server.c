@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* HTTP image server stand-in: answers range requests for a generated image or
+ * a file after the round trip and transfer time of the link, and drops the
+ * connection on request.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "server.h"
+
+static const uint8_t *file;
+static size_t file_size = CONFIG_FOTA_BENCH_IMAGE_SIZE;
+static uint32_t interrupt_at;
+static struct server_stats stats;
+static K_SPINLOCK_DEFINE(stats_lock);
+
+static void transfer_wait(size_t len)
+{
+	k_usleep(CONFIG_FOTA_BENCH_SERVER_LATENCY_MS * USEC_PER_MSEC +
+		 (uint64_t)len * USEC_PER_SEC / CONFIG_FOTA_BENCH_SERVER_RATE);
+}
+
+uint8_t server_image_byte(uint32_t offset)
+{
+	/* Knuth multiplicative hash, no run of erased bytes */
+	return (offset * 2654435761U) >> 24;
+}
+
+void server_file_set(const uint8_t *data, size_t size)
+{
+	file = data;
+	file_size = data ? size : CONFIG_FOTA_BENCH_IMAGE_SIZE;
+}
+
+void server_interrupt_at(uint32_t offset)
+{
+	K_SPINLOCK(&stats_lock) {
+		interrupt_at = offset;
+	}
+}
+
+int server_fetch(void *ctx, uint32_t offset, uint8_t *buf, size_t len)
+{
+	uint32_t cut = 0;
+
+	if (offset + len > file_size) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&stats_lock) {
+		stats.requests++;
+		if (interrupt_at > offset && interrupt_at < offset + len) {
+			cut = interrupt_at - offset;
+			interrupt_at = 0;
+			stats.interruptions++;
+		}
+		stats.bytes += cut ? cut : len;
+	}
+
+	if (cut) {
+		transfer_wait(cut);
+		return -ECONNRESET;
+	}
+
+	transfer_wait(len);
+
+	if (file) {
+		memcpy(buf, &file[offset], len);
+		return len;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = server_image_byte(offset + i);
+	}
+
+	return len;
+}
+
+void server_stats_get(struct server_stats *out)
+{
+	K_SPINLOCK(&stats_lock) {
+		*out = stats;
+	}
+}
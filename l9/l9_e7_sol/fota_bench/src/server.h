@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+/* Requests seen by the image server stand-in. */
+struct server_stats {
+	uint32_t requests;
+	/* Bytes sent, including the ones of interrupted requests. */
+	uint32_t bytes;
+	uint32_t interruptions;
+};
+
+/* @brief Byte of the generated image at offset. */
+uint8_t server_image_byte(uint32_t offset);
+
+/* @brief Serve a file instead of the generated image, NULL to go back to it. */
+void server_file_set(const uint8_t *data, size_t size);
+
+/* @brief Drop the connection once, while sending the byte at offset. */
+void server_interrupt_at(uint32_t offset);
+
+/* @brief Serve a range request, see fota_pipeline_fetch_t.
+ *
+ * Takes CONFIG_FOTA_BENCH_SERVER_LATENCY_MS plus the transfer time at
+ * CONFIG_FOTA_BENCH_SERVER_RATE.
+ *
+ * @return len, -ECONNRESET on an interruption or -EINVAL past the end.
+ */
+int server_fetch(void *ctx, uint32_t offset, uint8_t *buf, size_t len);
+
+/* @brief Get the request counters. */
+void server_stats_get(struct server_stats *stats);
+
+#endif /* SERVER_H_ */
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Encode cycles, size and stack usage of the l9_e7_sol shadow update.
+ *
+ * json_legacy:   descriptors built on the stack, json_obj_encode_buf() and strlen(),
+ *                as json_payload_construct() used to do.
+ * json_encode:   static descriptors, appended to the buffer with the length returned.
+ * json_template: fixed format string.
+ * json_len:      json_calc_encoded_len() only.
+ * cbor_encode:   zcbor map with integer keys, as published to the CBOR topic.
+ * cbor_decode:   the same map decoded back, as the cloud rule does.
+ *
+ * The reported state diff is checked against a sequence of accepted shadow
+ * documents before the benchmark.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/data/json.h>
+#include <zephyr/sys/printk.h>
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+
+#include <devacademy/bench.h>
+
+#include "json_payload.h"
+#include "cbor_payload.h"
+#include "reported_state.h"
+
+#define MESSAGE_SIZE 200
+#define STACK_SIZE   2048
+
+static const struct payload payload = {
+	.state.reported.uptime = 1234567,
+	.state.reported.app_version = "v1.0.0",
+	.state.reported.modem_version = "mfw_nrf91x1_2.0.2",
+};
+
+/* Update with an unchanged uptime left out, as the reported state diff does */
+static const struct payload partial = {
+	.state.reported.uptime = 1234567,
+	.state.reported.app_version = "v1.0.1",
+	.state.reported.modem_version = "mfw_nrf91x1_2.0.2",
+	.omit = PAYLOAD_FIELD_UPTIME,
+};
+
+static char message[MESSAGE_SIZE];
+static uint8_t cbor[MESSAGE_SIZE];
+static int cbor_len;
+
+/* Reported state read back from a CBOR message, strings point into the message */
+struct cbor_decoded {
+	/* PAYLOAD_FIELD_* bits of the keys found */
+	uint32_t fields;
+	uint32_t uptime;
+	struct zcbor_string app_version;
+	struct zcbor_string modem_version;
+};
+
+static int json_legacy(char *buf, size_t size, const struct payload *p)
+{
+	int err;
+	const struct json_obj_descr parameters[] = {
+		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "uptime",
+					  state.reported.uptime, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "app_version",
+					  state.reported.app_version, JSON_TOK_STRING),
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)
+		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "modem_version",
+					  state.reported.modem_version, JSON_TOK_STRING)
+#endif
+	};
+	const struct json_obj_descr reported[] = {
+		JSON_OBJ_DESCR_OBJECT_NAMED(struct payload, "reported", state.reported,
+					    parameters),
+	};
+	const struct json_obj_descr root[] = {
+		JSON_OBJ_DESCR_OBJECT(struct payload, state, reported),
+	};
+
+	memset(buf, 0, size);
+	err = json_obj_encode_buf(root, ARRAY_SIZE(root), p, buf, size);
+	if (err) {
+		return err;
+	}
+
+	return strlen(buf);
+}
+
+static uint32_t bench_legacy(uint32_t arg)
+{
+	return json_legacy(message, sizeof(message), &payload);
+}
+
+static uint32_t bench_encode(uint32_t arg)
+{
+	return json_payload_encode(message, sizeof(message), &payload);
+}
+
+static uint32_t bench_template(uint32_t arg)
+{
+	return json_payload_template(message, sizeof(message), &payload);
+}
+
+static uint32_t bench_len(uint32_t arg)
+{
+	return json_payload_len(&payload);
+}
+
+static uint32_t bench_cbor(uint32_t arg)
+{
+	return cbor_payload_construct(cbor, sizeof(cbor), &payload);
+}
+
+/* Decode the map of enum cbor_payload_key, an unknown or repeated key is an error */
+static int cbor_decode(const uint8_t *buf, size_t len, struct cbor_decoded *out)
+{
+	ZCBOR_STATE_D(zsd, 1, buf, len, 1, 0);
+	uint32_t key;
+	uint32_t field;
+	bool ok;
+
+	*out = (struct cbor_decoded){ 0 };
+
+	ok = zcbor_map_start_decode(zsd);
+
+	while (ok && !zcbor_array_at_end(zsd)) {
+		ok = zcbor_uint32_decode(zsd, &key);
+		if (!ok) {
+			break;
+		}
+
+		switch (key) {
+		case CBOR_PAYLOAD_KEY_UPTIME:
+			field = PAYLOAD_FIELD_UPTIME;
+			ok = zcbor_uint32_decode(zsd, &out->uptime);
+			break;
+		case CBOR_PAYLOAD_KEY_APP_VERSION:
+			field = PAYLOAD_FIELD_APP_VERSION;
+			ok = zcbor_tstr_decode(zsd, &out->app_version);
+			break;
+		case CBOR_PAYLOAD_KEY_MODEM_VERSION:
+			field = PAYLOAD_FIELD_MODEM_VERSION;
+			ok = zcbor_tstr_decode(zsd, &out->modem_version);
+			break;
+		default:
+			return -EBADMSG;
+		}
+
+		if (out->fields & field) {
+			return -EBADMSG;
+		}
+		out->fields |= field;
+	}
+
+	ok = ok && zcbor_map_end_decode(zsd);
+
+	/* Nothing may follow the map */
+	if (!ok || zsd->payload != buf + len) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+static uint32_t bench_cbor_decode(uint32_t arg)
+{
+	struct cbor_decoded decoded;
+
+	cbor_decode(cbor, cbor_len, &decoded);
+
+	return decoded.uptime;
+}
+
+BENCH_KERNEL_DEFINE(json_legacy, bench_legacy, 0);
+BENCH_KERNEL_DEFINE(json_encode, bench_encode, 0);
+BENCH_KERNEL_DEFINE(json_template, bench_template, 0);
+BENCH_KERNEL_DEFINE(json_len, bench_len, 0);
+BENCH_KERNEL_DEFINE(cbor_encode, bench_cbor, 0);
+BENCH_KERNEL_DEFINE(cbor_decode, bench_cbor_decode, 0);
+
+K_THREAD_STACK_DEFINE(probe_stack, STACK_SIZE);
+static struct k_thread probe_thread;
+
+static void probe_entry(void *fn, void *p2, void *p3)
+{
+	uint32_t (*kernel)(uint32_t) = fn;
+
+	kernel(0);
+}
+
+/* Run a variant once on a freshly painted stack and return the bytes it used */
+static size_t stack_used(uint32_t (*fn)(uint32_t))
+{
+	size_t unused = 0;
+
+	k_thread_create(&probe_thread, probe_stack, K_THREAD_STACK_SIZEOF(probe_stack),
+			probe_entry, fn, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_join(&probe_thread, K_FOREVER);
+	k_thread_stack_space_get(&probe_thread, &unused);
+
+	return K_THREAD_STACK_SIZEOF(probe_stack) - unused;
+}
+
+static bool zstr_equal(const struct zcbor_string *zstr, const char *str)
+{
+	return zstr->len == strlen(str) && memcmp(zstr->value, str, zstr->len) == 0;
+}
+
+/* Encode the payload, decode the message and compare the fields with the payload */
+static bool cbor_round_trip(const char *name, const struct payload *p)
+{
+	uint32_t fields = PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION;
+	struct cbor_decoded decoded;
+	bool match;
+	int len;
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)) {
+		fields |= PAYLOAD_FIELD_MODEM_VERSION;
+	}
+	fields &= ~p->omit;
+
+	len = cbor_payload_construct(cbor, sizeof(cbor), p);
+	match = len > 0 && cbor_decode(cbor, len, &decoded) == 0 && decoded.fields == fields;
+
+	if (match && (fields & PAYLOAD_FIELD_UPTIME)) {
+		match = decoded.uptime == p->state.reported.uptime;
+	}
+	if (match && (fields & PAYLOAD_FIELD_APP_VERSION)) {
+		match = zstr_equal(&decoded.app_version, p->state.reported.app_version);
+	}
+	if (match && (fields & PAYLOAD_FIELD_MODEM_VERSION)) {
+		match = zstr_equal(&decoded.modem_version, p->state.reported.modem_version);
+	}
+
+	printk("cbor %s round trip %s\n", name, match ? "matches" : "DIFFERS");
+
+	return match;
+}
+
+/* Diff an update against the acknowledged state and check the omitted fields,
+ * in the return value, the omit mask and the encoded message.
+ */
+static bool diff_check(const char *name, uint32_t uptime, const char *app_version,
+		       uint32_t expected_omit)
+{
+	static const char *const keys[] = { "\"uptime\"", "\"app_version\"",
+					    "\"modem_version\"" };
+	struct payload update = payload;
+	uint32_t fields = PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION;
+	bool match;
+	int count;
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)) {
+		fields |= PAYLOAD_FIELD_MODEM_VERSION;
+	}
+
+	update.state.reported.uptime = uptime;
+	update.state.reported.app_version = app_version;
+
+	count = reported_state_diff(&update);
+	match = update.omit == expected_omit &&
+		count == __builtin_popcount(fields & ~expected_omit);
+
+	/* An update with nothing left is not sent, so not encoded either */
+	if (match && count > 0) {
+		match = json_payload_encode(message, sizeof(message), &update) > 0;
+
+		for (size_t i = 0; match && i < ARRAY_SIZE(keys); i++) {
+			match = (strstr(message, keys[i]) != NULL) ==
+				((fields & ~expected_omit & BIT(i)) != 0);
+		}
+	}
+
+	printk("reported_state %s: %d fields, omit 0x%x %s\n", name, count, update.omit,
+	       match ? "as expected" : "UNEXPECTED");
+
+	return match;
+}
+
+static bool ack(const char *doc, bool full)
+{
+	return reported_state_ack(doc, strlen(doc), full) == 0;
+}
+
+/* Uptime of the acknowledged documents, in milliseconds as in the payload */
+#define ACKED_UPTIME 1000000
+
+static bool reported_state_check(void)
+{
+	/* Within the deadband when there is one, a change otherwise */
+	uint32_t uptime_near = ACKED_UPTIME + 5 * MSEC_PER_SEC;
+	uint32_t near_omit = CONFIG_AWS_IOT_SAMPLE_REPORTED_UPTIME_DEADBAND > 5 ?
+				     PAYLOAD_FIELD_UPTIME : 0;
+	bool passed = true;
+
+	passed &= diff_check("before any ack", ACKED_UPTIME, "v1.0.0", 0);
+
+	/* get/accepted: the shadow has uptime and app_version, not modem_version */
+	passed &= ack("{\"state\":{\"reported\":{\"uptime\":1000000,"
+		      "\"app_version\":\"v1.0.0\"}}}", true);
+	passed &= diff_check("unchanged", ACKED_UPTIME, "v1.0.0",
+			     PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION);
+	passed &= diff_check("app_version changed", ACKED_UPTIME, "v1.0.1",
+			     PAYLOAD_FIELD_UPTIME);
+	passed &= diff_check("uptime changed", uptime_near, "v1.0.0",
+			     near_omit | PAYLOAD_FIELD_APP_VERSION);
+
+	/* update/accepted merges the fields it holds into the cache */
+	passed &= ack("{\"state\":{\"reported\":{\"app_version\":\"v1.0.1\","
+		      "\"modem_version\":\"mfw_nrf91x1_2.0.2\"}}}", false);
+	passed &= diff_check("app_version acked", ACKED_UPTIME, "v1.0.1",
+			     PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION |
+				     PAYLOAD_FIELD_MODEM_VERSION);
+	passed &= diff_check("old app_version", ACKED_UPTIME, "v1.0.0",
+			     PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_MODEM_VERSION);
+
+	/* get/accepted replaces the cache, uptime is no longer known */
+	passed &= ack("{\"state\":{\"reported\":{\"app_version\":\"v1.0.1\"}}}", true);
+	passed &= diff_check("uptime dropped", ACKED_UPTIME, "v1.0.1",
+			     PAYLOAD_FIELD_APP_VERSION);
+
+	return passed;
+}
+
+/* Compare an encoder's output with the reference */
+static bool output_check(const char *name, int len, const char *reference)
+{
+	bool match = len == (int)strlen(reference) && strcmp(message, reference) == 0;
+
+	printk("%s output %s\n", name, match ? "matches" : "DIFFERS");
+
+	return match;
+}
+
+int main(void)
+{
+	static char reference[MESSAGE_SIZE];
+	bool passed = true;
+	int len;
+
+	len = json_legacy(reference, sizeof(reference), &payload);
+	printk("Reference (%d bytes): %s\n", len, reference);
+	if (len <= 0) {
+		printk("Shadow payload test FAILED\n");
+		return 0;
+	}
+
+	/* modem_version is encoded only when the field is enabled */
+	if ((strstr(reference, "\"modem_version\"") != NULL) !=
+	    IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)) {
+		printk("modem_version field %s\n",
+		       IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION) ? "missing"
+									    : "unexpected");
+		passed = false;
+	}
+
+	printk("json_calc_encoded_len: %d\n", (int)json_payload_len(&payload));
+	passed &= json_payload_len(&payload) == len;
+
+	len = json_payload_encode(message, sizeof(message), &payload);
+	passed &= output_check("json_encode", len, reference);
+	len = json_payload_template(message, sizeof(message), &payload);
+	passed &= output_check("json_template", len, reference);
+
+	passed &= reported_state_check();
+
+	passed &= cbor_round_trip("partial", &partial);
+	passed &= cbor_round_trip("full", &payload);
+
+	/* The message left in the buffer is the one the decode benchmark reads */
+	cbor_len = cbor_payload_construct(cbor, sizeof(cbor), &payload);
+	printk("cbor_encode: %d bytes, %d%% of the JSON message\n", cbor_len,
+	       (cbor_len * 100) / (int)strlen(reference));
+	for (int i = 0; i < cbor_len; i++) {
+		printk("%02x", cbor[i]);
+	}
+	printk("\n");
+
+	printk("variant,stack_bytes\n");
+	printk("json_legacy,%zu\n", stack_used(bench_legacy));
+	printk("json_encode,%zu\n", stack_used(bench_encode));
+	printk("json_template,%zu\n", stack_used(bench_template));
+	printk("json_len,%zu\n", stack_used(bench_len));
+	printk("cbor_encode,%zu\n", stack_used(bench_cbor));
+	printk("cbor_decode,%zu\n", stack_used(bench_cbor_decode));
+
+	bench_run_all();
+	printk("Benchmark finished\n");
+
+	if (passed) {
+		printk("Shadow payload test passed\n");
+	} else {
+		printk("Shadow payload test FAILED\n");
+	}
+
+	return 0;
+}
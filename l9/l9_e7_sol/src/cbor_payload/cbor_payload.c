@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/types.h>
+#include <zephyr/logging/log.h>
+#include <zcbor_common.h>
+#include <zcbor_encode.h>
+#include <devacademy/prof.h>
+
+#include "cbor_payload.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(cbor_payload, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)
+#define CBOR_PAYLOAD_FIELDS (PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION | \
+			     PAYLOAD_FIELD_MODEM_VERSION)
+#else
+#define CBOR_PAYLOAD_FIELDS (PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION)
+#endif
+
+static bool tstr_put(zcbor_state_t *zse, const char *str)
+{
+	return zcbor_tstr_encode_ptr(zse, str, strlen(str));
+}
+
+int cbor_payload_construct(uint8_t *buf, size_t size, const struct payload *payload)
+{
+	PROF_SCOPE("cbor_payload_construct");
+	/* One backup for the map header when zcbor produces canonical CBOR */
+	ZCBOR_STATE_E(zse, 1, buf, size, 1);
+	uint32_t fields = CBOR_PAYLOAD_FIELDS & ~payload->omit;
+	bool ok;
+
+	ok = zcbor_map_start_encode(zse, __builtin_popcount(CBOR_PAYLOAD_FIELDS));
+
+	if (fields & PAYLOAD_FIELD_UPTIME) {
+		ok = ok && zcbor_uint32_put(zse, CBOR_PAYLOAD_KEY_UPTIME) &&
+		     zcbor_uint32_put(zse, payload->state.reported.uptime);
+	}
+	if (fields & PAYLOAD_FIELD_APP_VERSION) {
+		ok = ok && zcbor_uint32_put(zse, CBOR_PAYLOAD_KEY_APP_VERSION) &&
+		     tstr_put(zse, payload->state.reported.app_version);
+	}
+	if (fields & PAYLOAD_FIELD_MODEM_VERSION) {
+		ok = ok && zcbor_uint32_put(zse, CBOR_PAYLOAD_KEY_MODEM_VERSION) &&
+		     tstr_put(zse, payload->state.reported.modem_version);
+	}
+
+	ok = ok && zcbor_map_end_encode(zse, __builtin_popcount(CBOR_PAYLOAD_FIELDS));
+
+	if (!ok) {
+		LOG_ERR("Shadow update does not fit in %zu bytes", size);
+		return -ENOMEM;
+	}
+
+	return zse->payload - buf;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CBOR_PAYLOAD_H_
+#define CBOR_PAYLOAD_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#include "json_payload.h"
+
+/* Keys of the CBOR map, the reported state only.
+ *
+ * {1: uptime, 2: app_version, 3: modem_version} decodes to
+ * {"state": {"reported": {"uptime": ..., "app_version": ..., "modem_version": ...}}}.
+ * Integer keys take a single byte each where the JSON names take up to 15.
+ */
+enum cbor_payload_key {
+	CBOR_PAYLOAD_KEY_UPTIME = 1,
+	CBOR_PAYLOAD_KEY_APP_VERSION = 2,
+	CBOR_PAYLOAD_KEY_MODEM_VERSION = 3,
+};
+
+/* @brief Encode the reported state of the payload as a CBOR map.
+ *
+ * modem_version is only encoded with CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION,
+ * as in the JSON message.
+ * Fields in payload->omit are left out of the map.
+ *
+ * @param[out] buf     Buffer that the CBOR message is written to.
+ * @param[in]  size    Size of the output buffer, buf.
+ * @param[in]  payload Pointer to a payload structure that will be used
+ *	       to populate the CBOR message.
+ *
+ * @return Length of the CBOR message on success, -ENOMEM if the buffer is too small.
+ */
+int cbor_payload_construct(uint8_t *buf, size_t size, const struct payload *payload);
+
+#endif /* CBOR_PAYLOAD_H_ */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Device identity read once instead of on every shadow update.
+ *
+ * A refresh fills the buffer readers are not using and then publishes it
+ * with an atomic pointer swap, so device_info_get() never waits for the
+ * modem.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <modem/modem_info.h>
+
+#include "device_info.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(device_info, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+static struct device_info infos[2] = {
+	{ .app_version = CONFIG_AWS_IOT_SAMPLE_APP_VERSION },
+	{ .app_version = CONFIG_AWS_IOT_SAMPLE_APP_VERSION },
+};
+
+static atomic_ptr_t current = ATOMIC_PTR_INIT(&infos[0]);
+
+/* Serializes refreshes, readers do not take it */
+static K_MUTEX_DEFINE(refresh_lock);
+
+static int modem_read(struct device_info *info)
+{
+	int err = 0;
+
+#if defined(CONFIG_MODEM_INFO)
+	int ret;
+
+	ret = modem_info_get_fw_version(info->modem_fw, sizeof(info->modem_fw));
+	if (ret) {
+		LOG_ERR("modem_info_get_fw_version, error: %d", ret);
+		err = ret;
+	}
+
+	ret = modem_info_string_get(MODEM_INFO_IMEI, info->imei, sizeof(info->imei));
+	if (ret < 0) {
+		LOG_ERR("modem_info_string_get, error: %d", ret);
+		err = err ? err : ret;
+	}
+#endif
+
+	return err;
+}
+
+int device_info_refresh(void)
+{
+	struct device_info *next;
+	int err;
+	int ret;
+
+	k_mutex_lock(&refresh_lock, K_FOREVER);
+
+	next = (atomic_ptr_get(&current) == &infos[0]) ? &infos[1] : &infos[0];
+	memset(next, 0, sizeof(*next));
+	next->app_version = CONFIG_AWS_IOT_SAMPLE_APP_VERSION;
+
+	err = hw_id_get(next->hw_id, sizeof(next->hw_id));
+	if (err) {
+		LOG_ERR("hw_id_get, error: %d", err);
+	}
+
+	ret = modem_read(next);
+	err = err ? err : ret;
+
+	LOG_DBG("hw_id %s, modem %s, IMEI %s", next->hw_id, next->modem_fw, next->imei);
+
+	atomic_ptr_set(&current, next);
+
+	k_mutex_unlock(&refresh_lock);
+
+	return err;
+}
+
+const struct device_info *device_info_get(void)
+{
+	return atomic_ptr_get(&current);
+}
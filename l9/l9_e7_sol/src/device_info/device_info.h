@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DEVICE_INFO_H_
+#define DEVICE_INFO_H_
+
+#include <hw_id.h>
+
+#define DEVICE_INFO_MODEM_FW_LEN 50
+#define DEVICE_INFO_IMEI_LEN	 16
+
+/* Static identity of the device. Strings that could not be read are empty. */
+struct device_info {
+	const char *app_version;
+	char hw_id[HW_ID_LEN];
+	/* Modem firmware version and IMEI, only read with CONFIG_MODEM_INFO */
+	char modem_fw[DEVICE_INFO_MODEM_FW_LEN];
+	char imei[DEVICE_INFO_IMEI_LEN];
+};
+
+/* @brief Read the device identity into the cache.
+ *
+ * Blocks on AT commands with CONFIG_MODEM_INFO. Call it once the modem is
+ * initialized and again when a modem FOTA has completed.
+ *
+ * @return 0 on success, otherwise the first error met. The fields that could be read
+ *	   are cached either way.
+ */
+int device_info_refresh(void);
+
+/* @brief Get the cached device identity without blocking.
+ *
+ * The returned information stays valid until the second device_info_refresh()
+ * after this call, so it should not be kept beyond the current work item.
+ *
+ * @return Cached information, with empty strings before the first refresh.
+ */
+const struct device_info *device_info_get(void);
+
+#endif /* DEVICE_INFO_H_ */
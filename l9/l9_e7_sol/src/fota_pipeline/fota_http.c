@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* HTTP range request source of the download pipeline. */
+
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/data/json.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/tls_credentials.h>
+#include <zephyr/net/http/client.h>
+
+#include "fota_http.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(fota_http, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define SEC_TAG		CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_SEC_TAG
+#define TIMEOUT_MS	30000
+
+struct fota_request {
+	const char *url;
+	int32_t size;
+};
+
+static const struct json_obj_descr fota_request_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct fota_request, url, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct fota_request, size, JSON_TOK_NUMBER),
+};
+
+/* Body of the response being received */
+struct range {
+	uint8_t *buf;
+	size_t len;
+	size_t received;
+	uint16_t status;
+};
+
+/* Headers and body fragments pass through it before being copied to the chunk */
+static uint8_t recv_buf[1024];
+
+int fota_http_request_parse(char *msg, size_t len, const char **url, uint32_t *size)
+{
+	struct fota_request req = { 0 };
+	int ret;
+
+	ret = json_obj_parse(msg, len, fota_request_descr, ARRAY_SIZE(fota_request_descr), &req);
+	if (ret != BIT_MASK(ARRAY_SIZE(fota_request_descr)) || req.size <= 0) {
+		return -EINVAL;
+	}
+
+	*url = req.url;
+	*size = req.size;
+
+	return 0;
+}
+
+int fota_http_init(struct fota_http *http, const char *url)
+{
+	const char *path;
+	size_t host_len;
+
+	if (strncmp(url, "https://", 8) == 0) {
+		url += 8;
+	} else if (strncmp(url, "http://", 7) == 0) {
+		url += 7;
+	}
+
+	path = strchr(url, '/');
+	if (!path) {
+		return -EINVAL;
+	}
+
+	host_len = path - url;
+	if (host_len == 0 || host_len > FOTA_HTTP_HOST_LEN_MAX || strlen(path) >= sizeof(http->path)) {
+		return -EINVAL;
+	}
+
+	memcpy(http->host, url, host_len);
+	http->host[host_len] = '\0';
+	strcpy(http->path, path);
+	http->sock = -1;
+
+	return 0;
+}
+
+static int http_connect(struct fota_http *http)
+{
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res;
+	int err;
+
+	err = zsock_getaddrinfo(http->host, (SEC_TAG >= 0) ? "443" : "80", &hints, &res);
+	if (err) {
+		LOG_ERR("getaddrinfo %s, error: %d", http->host, err);
+		return -EHOSTUNREACH;
+	}
+
+	http->sock = zsock_socket(res->ai_family, SOCK_STREAM,
+				  (SEC_TAG >= 0) ? IPPROTO_TLS_1_2 : IPPROTO_TCP);
+	if (http->sock < 0) {
+		err = -errno;
+		goto out;
+	}
+
+#if SEC_TAG >= 0
+	sec_tag_t sec_tag = SEC_TAG;
+	int cache = TLS_SESSION_CACHE_ENABLED;
+
+	/* The session is resumed when connecting again after an interruption */
+	if (zsock_setsockopt(http->sock, SOL_TLS, TLS_SEC_TAG_LIST, &sec_tag, sizeof(sec_tag)) ||
+	    zsock_setsockopt(http->sock, SOL_TLS, TLS_HOSTNAME, http->host,
+			     strlen(http->host) + 1) ||
+	    zsock_setsockopt(http->sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache))) {
+		err = -errno;
+		goto out;
+	}
+#endif
+
+	if (zsock_connect(http->sock, res->ai_addr, res->ai_addrlen)) {
+		err = -errno;
+		goto out;
+	}
+
+out:
+	zsock_freeaddrinfo(res);
+
+	if (err) {
+		LOG_ERR("Connecting to %s, error: %d", http->host, err);
+		fota_http_close(http);
+	}
+
+	return err;
+}
+
+static int response_cb(struct http_response *rsp, enum http_final_call final_data,
+		       void *user_data)
+{
+	struct range *range = user_data;
+	size_t len;
+
+	range->status = rsp->http_status_code;
+
+	if (rsp->body_frag_start && rsp->body_frag_len) {
+		len = MIN(rsp->body_frag_len, range->len - range->received);
+		memcpy(&range->buf[range->received], rsp->body_frag_start, len);
+		range->received += len;
+	}
+
+	return 0;
+}
+
+int fota_http_fetch(void *ctx, uint32_t offset, uint8_t *buf, size_t len)
+{
+	struct fota_http *http = ctx;
+	struct range range = {
+		.buf = buf,
+		.len = len,
+	};
+	char range_header[48];
+	const char *headers[] = { range_header, NULL };
+	struct http_request req = {
+		.method = HTTP_GET,
+		.url = http->path,
+		.host = http->host,
+		.protocol = "HTTP/1.1",
+		.header_fields = headers,
+		.response = response_cb,
+		.recv_buf = recv_buf,
+		.recv_buf_len = sizeof(recv_buf),
+	};
+	bool reused = (http->sock >= 0);
+	int ret;
+
+	snprintf(range_header, sizeof(range_header), "Range: bytes=%u-%u\r\n", offset,
+		 offset + len - 1);
+
+	for (;;) {
+		if (http->sock < 0) {
+			ret = http_connect(http);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		ret = http_client_req(http->sock, &req, TIMEOUT_MS, &range);
+		if (ret >= 0) {
+			break;
+		}
+
+		fota_http_close(http);
+
+		/* The server may have closed the idle connection, try once on a new one */
+		if (!reused || range.received) {
+			LOG_WRN("http_client_req, error: %d", ret);
+			return ret;
+		}
+
+		reused = false;
+	}
+
+	/* A server ignoring the range would send the whole image */
+	if (range.status != 206 || range.received == 0) {
+		LOG_ERR("Range request answered with status %u", range.status);
+		fota_http_close(http);
+		return -EBADMSG;
+	}
+
+	return range.received;
+}
+
+void fota_http_close(struct fota_http *http)
+{
+	if (http->sock >= 0) {
+		(void)zsock_close(http->sock);
+		http->sock = -1;
+	}
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FOTA_HTTP_H_
+#define FOTA_HTTP_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#define FOTA_HTTP_HOST_LEN_MAX 64
+
+/* Image server connection, kept open between range requests. */
+struct fota_http {
+	char host[FOTA_HTTP_HOST_LEN_MAX + 1];
+	char path[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+	int sock;
+};
+
+/* @brief Parse a download request, {"url":"host/path","size":bytes}.
+ *
+ * @param[in] msg Message, modified while parsing.
+ * @param[out] url Points into msg.
+ */
+int fota_http_request_parse(char *msg, size_t len, const char **url, uint32_t *size);
+
+/* @brief Set the image URL, host/path with an optional http:// or https:// prefix. */
+int fota_http_init(struct fota_http *http, const char *url);
+
+/* @brief Fetch a range of the image, see fota_pipeline_fetch_t.
+ *
+ * Connects on the first call and again after an error.
+ */
+int fota_http_fetch(void *ctx, uint32_t offset, uint8_t *buf, size_t len);
+
+/* @brief Close the connection. */
+void fota_http_close(struct fota_http *http);
+
+#endif /* FOTA_HTTP_H_ */
@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Resumable image download into the secondary slot.
+ *
+ * The fetch thread takes a free buffer, fills it with the next chunk of the
+ * image and passes it to the writer thread, which writes it through
+ * stream_flash and hands the buffer back. With two buffers the next chunk is
+ * on its way while the previous one is written. A chunk of length 0 ends the
+ * download, a negative length carries the error that stopped it.
+ *
+ * Every CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_CHECKPOINT_BYTES the stream is
+ * flushed and the offset reached, rounded down to the start of its flash
+ * page, is saved to settings with the image identifier. Resuming erases and
+ * writes that page again, so at most a checkpoint interval and a page are
+ * fetched twice.
+ *
+ * With CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA, a download starting with
+ * the patch magic goes through the delta applier, which rebuilds the new
+ * image from the one in the primary slot.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/storage/stream_flash.h>
+#include <zephyr/settings/settings.h>
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+#include <devacademy/delta.h>
+#endif
+
+#include "fota_pipeline.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(fota_pipeline, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define SLOT_PARTITION_ID	FIXED_PARTITION_ID(slot1_partition)
+#define OLD_PARTITION_ID	FIXED_PARTITION_ID(slot0_partition)
+
+#define CHUNK_SIZE		CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_CHUNK_SIZE
+#define BUFFERS			CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_BUFFERS
+#define CHECKPOINT_BYTES	CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_CHECKPOINT_BYTES
+#define ID_LEN_MAX		CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX
+#define STACK_SIZE		CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_STACK_SIZE
+
+/* Multiple of the write block size of the DKs */
+#define WRITE_BUF_SIZE		512
+
+/* The fetcher mostly waits for the network, it goes first to keep a request in flight */
+#define FETCH_THREAD_PRIO	K_PRIO_PREEMPT(6)
+#define WRITER_THREAD_PRIO	K_PRIO_PREEMPT(7)
+
+#define SETTINGS_SUBTREE	"fota_pipe"
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+#define IS_DELTA()		(fp.delta)
+#else
+#define IS_DELTA()		false
+#endif
+
+struct checkpoint {
+	uint32_t size;
+	/* Bytes of the image on flash */
+	uint32_t offset;
+};
+
+struct chunk {
+	uint8_t buf;
+	int len;
+};
+
+static struct {
+	fota_pipeline_done_t done;
+	fota_pipeline_fetch_t fetch;
+	void *ctx;
+	char id[ID_LEN_MAX + 1];
+	struct checkpoint ckpt;
+	/* Offset the running download started at */
+	uint32_t start;
+	int64_t started_at;
+	const struct flash_area *fa;
+	struct stream_flash_ctx stream;
+	struct fota_pipeline_stats stats;
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+	/* The download is a patch against the image in old_fa */
+	bool delta;
+	const struct flash_area *old_fa;
+	struct delta_ctx patch;
+#endif
+} fp;
+
+static atomic_t running;
+static atomic_t stopping;
+
+static K_SPINLOCK_DEFINE(stats_lock);
+
+static uint8_t chunk_bufs[BUFFERS][CHUNK_SIZE] __aligned(4);
+static uint8_t write_buf[WRITE_BUF_SIZE] __aligned(4);
+
+K_MSGQ_DEFINE(free_msgq, sizeof(uint8_t), BUFFERS, 1);
+K_MSGQ_DEFINE(filled_msgq, sizeof(struct chunk), BUFFERS, 4);
+static K_SEM_DEFINE(fetch_sem, 0, 1);
+
+static void stats_add(uint32_t *counter, uint32_t value)
+{
+	K_SPINLOCK(&stats_lock) {
+		*counter += value;
+	}
+}
+
+static int settings_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	int rc;
+
+	if (settings_name_steq(key, "id", &next) && !next) {
+		if (len > ID_LEN_MAX) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, fp.id, len);
+		if (rc < 0) {
+			return rc;
+		}
+
+		fp.id[rc] = '\0';
+		return 0;
+	}
+
+	if (settings_name_steq(key, "state", &next) && !next) {
+		if (len != sizeof(fp.ckpt)) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, &fp.ckpt, sizeof(fp.ckpt));
+
+		return (rc < 0) ? rc : 0;
+	}
+
+	return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(fota_pipeline, SETTINGS_SUBTREE, NULL, settings_set, NULL, NULL);
+
+static uint32_t page_start(uint32_t offset)
+{
+	struct flash_pages_info info;
+
+	if (flash_get_page_info_by_offs(flash_area_get_device(fp.fa), fp.fa->fa_off + offset,
+					&info)) {
+		return 0;
+	}
+
+	return info.start_offset - fp.fa->fa_off;
+}
+
+static int stream_flush(void)
+{
+	int err;
+
+	err = stream_flash_buffered_write(&fp.stream, NULL, 0, true);
+	if (err) {
+		LOG_ERR("stream_flash_buffered_write, error: %d", err);
+	}
+
+	return err;
+}
+
+/* Offset of the image up to which everything is on flash, once flushed */
+static uint32_t resume_offset(void)
+{
+	uint32_t offset = fp.start + stream_flash_bytes_written(&fp.stream);
+
+	return (offset < fp.ckpt.size) ? page_start(offset) : offset;
+}
+
+/* Best effort, a download without checkpoint restarts from the last one saved */
+static void checkpoint_save(uint32_t offset)
+{
+	int err;
+
+	if (offset <= fp.ckpt.offset && offset < fp.ckpt.size) {
+		return;
+	}
+
+	fp.ckpt.offset = offset;
+
+	err = settings_save_one(SETTINGS_SUBTREE "/state", &fp.ckpt, sizeof(fp.ckpt));
+	if (err) {
+		LOG_WRN("Checkpoint not saved, error: %d", err);
+		return;
+	}
+
+	stats_add(&fp.stats.checkpoints, 1);
+}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+static int delta_read_old(void *user, uint32_t offset, uint8_t *buf, size_t len)
+{
+	return flash_area_read(fp.old_fa, offset, buf, len);
+}
+
+static int delta_write_new(void *user, const uint8_t *data, size_t len)
+{
+	return stream_flash_buffered_write(&fp.stream, data, len, false);
+}
+#endif
+
+/* Forget the image, the next download starts from the beginning */
+static int checkpoint_delete(void)
+{
+	int err;
+
+	fp.id[0] = '\0';
+	memset(&fp.ckpt, 0, sizeof(fp.ckpt));
+
+	err = settings_delete(SETTINGS_SUBTREE "/id");
+	if (!err) {
+		err = settings_delete(SETTINGS_SUBTREE "/state");
+	}
+
+	return err;
+}
+
+static int chunk_write(const uint8_t *data, size_t len, bool first)
+{
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+	/* No checkpoint is saved for a patch, an interrupted one is not resumed */
+	if (first && fp.start == 0) {
+		fp.delta = delta_is_patch(data, len);
+		if (fp.delta) {
+			int err;
+
+			LOG_INF("Applying a delta patch to the primary slot image");
+			err = delta_init(&fp.patch, delta_read_old, delta_write_new, NULL);
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	if (fp.delta) {
+		return delta_feed(&fp.patch, data, len);
+	}
+#endif
+
+	return stream_flash_buffered_write(&fp.stream, data, len, false);
+}
+
+/* Finish the image once all the chunks are written */
+static int image_finish(void)
+{
+	int err;
+
+	err = stream_flush();
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+	if (fp.delta) {
+		err = err ? err : delta_finish(&fp.patch);
+		if (err) {
+			delta_abort(&fp.patch);
+		}
+	}
+#endif
+
+	return err;
+}
+
+static void fetch_thread(void *p1, void *p2, void *p3)
+{
+	struct chunk chunk;
+	uint32_t offset;
+	int64_t t;
+
+	for (;;) {
+		k_sem_take(&fetch_sem, K_FOREVER);
+		offset = fp.start;
+
+		do {
+			t = k_uptime_get();
+			(void)k_msgq_get(&free_msgq, &chunk.buf, K_FOREVER);
+			stats_add(&fp.stats.fetch_idle_ms, k_uptime_get() - t);
+
+			if (offset == fp.ckpt.size) {
+				chunk.len = 0;
+			} else if (atomic_get(&stopping)) {
+				chunk.len = -ECANCELED;
+			} else {
+				t = k_uptime_get();
+				chunk.len = fp.fetch(fp.ctx, offset, chunk_bufs[chunk.buf],
+						     MIN(CHUNK_SIZE, fp.ckpt.size - offset));
+				stats_add(&fp.stats.fetch_ms, k_uptime_get() - t);
+
+				if (chunk.len == 0) {
+					chunk.len = -EIO;
+				} else if (chunk.len > 0) {
+					offset += chunk.len;
+					stats_add(&fp.stats.fetched, chunk.len);
+				}
+			}
+
+			(void)k_msgq_put(&filled_msgq, &chunk, K_FOREVER);
+		} while (chunk.len > 0);
+	}
+}
+
+/* Write the chunks of a download, returns once the fetcher is done with it */
+static int chunks_write(void)
+{
+	uint32_t checkpoint_at = CHECKPOINT_BYTES;
+	uint32_t written = 0;
+	struct chunk chunk;
+	int64_t t;
+	int err = 0;
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+	fp.delta = false;
+#endif
+
+	for (;;) {
+		t = k_uptime_get();
+		(void)k_msgq_get(&filled_msgq, &chunk, K_FOREVER);
+		stats_add(&fp.stats.write_idle_ms, k_uptime_get() - t);
+
+		if (chunk.len <= 0) {
+			(void)k_msgq_put(&free_msgq, &chunk.buf, K_NO_WAIT);
+			break;
+		}
+
+		/* After an error, only hand the buffers back until the fetcher stops */
+		if (!err) {
+			t = k_uptime_get();
+			err = chunk_write(chunk_bufs[chunk.buf], chunk.len, written == 0);
+			stats_add(&fp.stats.write_ms, k_uptime_get() - t);
+
+			if (err) {
+				LOG_ERR("Chunk write, error: %d", err);
+				atomic_set(&stopping, 1);
+			}
+		}
+
+		(void)k_msgq_put(&free_msgq, &chunk.buf, K_NO_WAIT);
+		written += chunk.len;
+
+		/* The state of a patch is not saved, it is applied again from the start */
+		if (!err && written >= checkpoint_at && !IS_DELTA()) {
+			err = stream_flush();
+			if (err) {
+				atomic_set(&stopping, 1);
+			} else {
+				checkpoint_save(resume_offset());
+			}
+			checkpoint_at += CHECKPOINT_BYTES;
+		}
+	}
+
+	t = k_uptime_get();
+
+	if (!err && chunk.len == 0) {
+		/* Complete, the checkpoint marks it so */
+		err = image_finish();
+		if (!err) {
+			checkpoint_save(fp.ckpt.size);
+		}
+	} else {
+		/* Keep what was written before the interruption */
+		if (!stream_flush() && !IS_DELTA()) {
+			checkpoint_save(resume_offset());
+		}
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+		if (fp.delta) {
+			delta_abort(&fp.patch);
+			if (checkpoint_delete()) {
+				LOG_WRN("Checkpoint of the patch not deleted");
+			}
+		}
+#endif
+		err = err ? err : chunk.len;
+	}
+
+	K_SPINLOCK(&stats_lock) {
+		fp.stats.write_ms += k_uptime_get() - t;
+		fp.stats.written = stream_flash_bytes_written(&fp.stream);
+	}
+
+	return err;
+}
+
+static void writer_thread(void *p1, void *p2, void *p3)
+{
+	struct fota_pipeline_stats stats;
+	int err;
+
+	for (;;) {
+		err = chunks_write();
+
+		K_SPINLOCK(&stats_lock) {
+			fp.stats.elapsed_ms = k_uptime_get() - fp.started_at;
+			stats = fp.stats;
+		}
+
+		if (err) {
+			LOG_WRN("Download stopped at %u of %u bytes, error: %d", fp.ckpt.offset,
+				fp.ckpt.size, err);
+		} else {
+			LOG_INF("Download of %u bytes complete", fp.ckpt.size);
+		}
+		LOG_INF("%u bytes fetched in %u ms, %u B/s, fetch %u ms, write %u ms, "
+			"writer idle %u ms", stats.fetched, stats.elapsed_ms,
+			stats.elapsed_ms ? (uint32_t)((uint64_t)stats.fetched * MSEC_PER_SEC /
+						      stats.elapsed_ms) : 0,
+			stats.fetch_ms, stats.write_ms, stats.write_idle_ms);
+
+		atomic_clear(&running);
+
+		if (fp.done) {
+			fp.done(err);
+		}
+	}
+}
+
+K_THREAD_DEFINE(fota_fetch, STACK_SIZE, fetch_thread, NULL, NULL, NULL,
+		FETCH_THREAD_PRIO, 0, 0);
+K_THREAD_DEFINE(fota_writer, STACK_SIZE, writer_thread, NULL, NULL, NULL,
+		WRITER_THREAD_PRIO, 0, 0);
+
+int fota_pipeline_init(fota_pipeline_done_t done)
+{
+	int err;
+
+	if (fota_pipeline_busy()) {
+		return -EBUSY;
+	}
+
+	fp.done = done;
+
+	if (!fp.fa) {
+		err = flash_area_open(SLOT_PARTITION_ID, &fp.fa);
+		if (err) {
+			LOG_ERR("flash_area_open, error: %d", err);
+			return err;
+		}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_DELTA)
+		err = flash_area_open(OLD_PARTITION_ID, &fp.old_fa);
+		if (err) {
+			LOG_ERR("flash_area_open, error: %d", err);
+			return err;
+		}
+#endif
+
+		for (uint8_t i = 0; i < BUFFERS; i++) {
+			(void)k_msgq_put(&free_msgq, &i, K_NO_WAIT);
+		}
+	}
+
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("settings_subsys_init, error: %d", err);
+		return err;
+	}
+
+	fp.id[0] = '\0';
+	memset(&fp.ckpt, 0, sizeof(fp.ckpt));
+
+	err = settings_load_subtree(SETTINGS_SUBTREE);
+	if (err) {
+		LOG_ERR("settings_load_subtree, error: %d", err);
+		return err;
+	}
+
+	if (fp.id[0] != '\0') {
+		LOG_INF("Checkpoint of %s at %u of %u bytes", fp.id, fp.ckpt.offset,
+			fp.ckpt.size);
+	}
+
+	return 0;
+}
+
+int fota_pipeline_start(const char *id, uint32_t size, fota_pipeline_fetch_t fetch, void *ctx)
+{
+	int err;
+
+	if (!fp.fa) {
+		return -EACCES;
+	}
+
+	if (strlen(id) > ID_LEN_MAX || size == 0) {
+		return -EINVAL;
+	}
+
+	if (size > fp.fa->fa_size) {
+		return -EFBIG;
+	}
+
+	if (!atomic_cas(&running, 0, 1)) {
+		return -EBUSY;
+	}
+
+	if (strcmp(fp.id, id) != 0 || fp.ckpt.size != size) {
+		strcpy(fp.id, id);
+		fp.ckpt.size = size;
+		fp.ckpt.offset = 0;
+
+		/* Without a checkpoint the download still works, it cannot resume */
+		err = settings_save_one(SETTINGS_SUBTREE "/id", fp.id, strlen(fp.id));
+		if (!err) {
+			err = settings_save_one(SETTINGS_SUBTREE "/state", &fp.ckpt,
+						sizeof(fp.ckpt));
+		}
+		if (err) {
+			LOG_WRN("Checkpoint not saved, error: %d", err);
+		}
+	} else if (fp.ckpt.offset >= size) {
+		atomic_clear(&running);
+		return -EALREADY;
+	}
+
+	fp.start = fp.ckpt.offset;
+
+	err = stream_flash_init(&fp.stream, flash_area_get_device(fp.fa), write_buf,
+				sizeof(write_buf), fp.fa->fa_off + fp.start,
+				fp.fa->fa_size - fp.start, NULL);
+	if (err) {
+		LOG_ERR("stream_flash_init, error: %d", err);
+		atomic_clear(&running);
+		return err;
+	}
+
+	K_SPINLOCK(&stats_lock) {
+		memset(&fp.stats, 0, sizeof(fp.stats));
+		fp.stats.size = size;
+		fp.stats.resumed_from = fp.start;
+		fp.started_at = k_uptime_get();
+	}
+
+	fp.fetch = fetch;
+	fp.ctx = ctx;
+	atomic_clear(&stopping);
+
+	LOG_INF("Downloading %s from offset %u of %u", id, fp.start, size);
+
+	k_sem_give(&fetch_sem);
+
+	return 0;
+}
+
+bool fota_pipeline_busy(void)
+{
+	return atomic_get(&running) != 0;
+}
+
+void fota_pipeline_stop(void)
+{
+	atomic_set(&stopping, 1);
+}
+
+int fota_pipeline_pending(char *id, size_t id_size, uint32_t *size, uint32_t *offset)
+{
+	if (fp.id[0] == '\0' || fp.ckpt.size == 0 || fp.ckpt.offset >= fp.ckpt.size) {
+		return -ENOENT;
+	}
+
+	if (strlen(fp.id) >= id_size) {
+		return -ENOMEM;
+	}
+
+	strcpy(id, fp.id);
+	*size = fp.ckpt.size;
+	*offset = fp.ckpt.offset;
+
+	return 0;
+}
+
+int fota_pipeline_clear(void)
+{
+	if (fota_pipeline_busy()) {
+		return -EBUSY;
+	}
+
+	return checkpoint_delete();
+}
+
+void fota_pipeline_stats_get(struct fota_pipeline_stats *stats)
+{
+	K_SPINLOCK(&stats_lock) {
+		*stats = fp.stats;
+	}
+}
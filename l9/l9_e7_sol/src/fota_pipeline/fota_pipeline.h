@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FOTA_PIPELINE_H_
+#define FOTA_PIPELINE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+/* @brief Fetch bytes [offset, offset + len) of the image.
+ *
+ * Called from the fetch thread.
+ *
+ * @return Number of bytes fetched, at least 1 and at most len, or a negative error code.
+ */
+typedef int (*fota_pipeline_fetch_t)(void *ctx, uint32_t offset, uint8_t *buf, size_t len);
+
+/* @brief Called from the writer thread once the download stopped.
+ *
+ * @param err 0 if the whole image is in the secondary slot, otherwise the error
+ *	      that stopped the download. The checkpoint is kept to resume it,
+ *	      except for a delta patch, which is not resumed.
+ */
+typedef void (*fota_pipeline_done_t)(int err);
+
+/* Cost of the last download. */
+struct fota_pipeline_stats {
+	uint32_t size;
+	/* Offset the download started at, from the checkpoint. */
+	uint32_t resumed_from;
+	/* Bytes fetched, including the ones fetched again after the checkpoint. */
+	uint32_t fetched;
+	/* Bytes written to the slot, more than fetched when applying a patch. */
+	uint32_t written;
+	uint32_t elapsed_ms;
+	/* Time spent in the fetch function and in the flash writes. With more
+	 * than one buffer they overlap and add up to more than elapsed_ms.
+	 */
+	uint32_t fetch_ms;
+	uint32_t write_ms;
+	/* Time the writer waited for a chunk, and the fetcher for a free buffer. */
+	uint32_t write_idle_ms;
+	uint32_t fetch_idle_ms;
+	uint32_t checkpoints;
+};
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE)
+
+/* @brief Load the checkpoint from settings.
+ *
+ * @param[in] done Called at the end of every download.
+ */
+int fota_pipeline_init(fota_pipeline_done_t done);
+
+/* @brief Start downloading an image into the secondary slot.
+ *
+ * Resumes from the checkpoint if it is for the same image, otherwise starts
+ * from the beginning and replaces the checkpoint.
+ *
+ * @param[in] id Identifier of the image, its URL.
+ * @param[in] size Size of the image.
+ *
+ * @return 0 on success, -EBUSY if a download is running, -EALREADY if the
+ *	   image is already complete in the secondary slot.
+ */
+int fota_pipeline_start(const char *id, uint32_t size, fota_pipeline_fetch_t fetch, void *ctx);
+
+/* @brief Check if a download is running. */
+bool fota_pipeline_busy(void);
+
+/* @brief Stop the running download after the current chunk, keeping the checkpoint. */
+void fota_pipeline_stop(void);
+
+/* @brief Get the checkpoint of an interrupted download.
+ *
+ * @return 0 with the identifier and the offset reached, -ENOENT if there is none
+ *	   or the image is complete.
+ */
+int fota_pipeline_pending(char *id, size_t id_size, uint32_t *size, uint32_t *offset);
+
+/* @brief Forget the checkpoint, the next download starts from the beginning. */
+int fota_pipeline_clear(void);
+
+/* @brief Get the counters of the last download. */
+void fota_pipeline_stats_get(struct fota_pipeline_stats *stats);
+
+#else
+
+static inline void fota_pipeline_stop(void)
+{
+}
+
+#endif /* CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE */
+
+#endif /* FOTA_PIPELINE_H_ */
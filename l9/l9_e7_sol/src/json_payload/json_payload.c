@@ -4,41 +4,182 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <errno.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/data/json.h>
+#include <zephyr/sys/printk.h>
+#include <devacademy/prof.h>
 
 #include "json_payload.h"
 
 /* Register log module */
 LOG_MODULE_REGISTER(json_payload, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
 
-int json_payload_construct(char *message, size_t size, struct payload *payload)
+/* Descriptors of the shadow update, built once instead of on every call */
+static const struct json_obj_descr parameters[] = {
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "uptime",
+				  state.reported.uptime, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "app_version",
+				  state.reported.app_version, JSON_TOK_STRING),
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "modem_version",
+				  state.reported.modem_version, JSON_TOK_STRING)
+#endif
+};
+
+static const struct json_obj_descr reported[] = {
+	JSON_OBJ_DESCR_OBJECT_NAMED(struct payload, "reported", state.reported,
+				    parameters),
+};
+
+static const struct json_obj_descr root[] = {
+	JSON_OBJ_DESCR_OBJECT(struct payload, state, reported),
+};
+
+/* Descriptors of a payload with omitted fields */
+struct payload_descr {
+	struct json_obj_descr parameters[ARRAY_SIZE(parameters)];
+	struct json_obj_descr reported;
+	struct json_obj_descr root;
+};
+
+/* The entries of parameters[] are in PAYLOAD_FIELD_* bit order */
+static const struct json_obj_descr *payload_descr_get(const struct payload *payload,
+						      struct payload_descr *descr)
 {
-	int err;
-	const struct json_obj_descr parameters[] = {
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "uptime",
-					  state.reported.uptime, JSON_TOK_NUMBER),
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "app_version",
-					  state.reported.app_version, JSON_TOK_STRING),
-#if defined(CONFIG_MODEM_INFO)
-		JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "modem_version",
-					  state.reported.modem_version, JSON_TOK_STRING)
+	size_t count = 0;
+
+	if (payload->omit == 0) {
+		return root;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(parameters); i++) {
+		if (!(payload->omit & BIT(i))) {
+			descr->parameters[count++] = parameters[i];
+		}
+	}
+
+	descr->reported = reported[0];
+	descr->reported.object.sub_descr = descr->parameters;
+	descr->reported.object.sub_descr_len = count;
+	descr->root = root[0];
+	descr->root.object.sub_descr = &descr->reported;
+
+	return &descr->root;
+}
+
+/* Same layout as the descriptors above, uptime is encoded as a signed 32-bit number */
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)
+#define PAYLOAD_TEMPLATE "{\"state\":{\"reported\":{\"uptime\":%d,\"app_version\":\"%s\"," \
+			 "\"modem_version\":\"%s\"}}}"
+#else
+#define PAYLOAD_TEMPLATE "{\"state\":{\"reported\":{\"uptime\":%d,\"app_version\":\"%s\"}}}"
 #endif
+
+struct message_buf {
+	char *buf;
+	size_t size;
+	size_t len;
+};
+
+static int message_append(const char *bytes, size_t len, void *data)
+{
+	struct message_buf *msg = data;
+
+	/* Keep room for the terminator */
+	if (len >= msg->size - msg->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(&msg->buf[msg->len], bytes, len);
+	msg->len += len;
+
+	return 0;
+}
+
+int json_payload_encode(char *message, size_t size, const struct payload *payload)
+{
+	struct message_buf msg = {
+		.buf = message,
+		.size = size,
 	};
-	const struct json_obj_descr reported[] = {
-		JSON_OBJ_DESCR_OBJECT_NAMED(struct payload, "reported", state.reported,
-					    parameters),
-	};
-	const struct json_obj_descr root[] = {
-		JSON_OBJ_DESCR_OBJECT(struct payload, state, reported),
-	};
+	struct payload_descr descr;
+	int err;
+
+	if (size == 0) {
+		return -ENOMEM;
+	}
 
-	err = json_obj_encode_buf(root, ARRAY_SIZE(root), payload, message, size);
+	err = json_obj_encode(payload_descr_get(payload, &descr), ARRAY_SIZE(root), payload,
+			      message_append, &msg);
 	if (err) {
-		LOG_ERR("json_obj_encode_buf, error: %d", err);
+		LOG_ERR("json_obj_encode, error: %d", err);
 		return err;
 	}
 
-	return 0;
+	message[msg.len] = '\0';
+
+	return msg.len;
+}
+
+/* True if the string can be copied into a JSON string without escaping */
+static bool json_plain(const char *str)
+{
+	for (; *str != '\0'; str++) {
+		if (*str == '"' || *str == '\\' || (uint8_t)*str < 0x20) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int json_payload_template(char *message, size_t size, const struct payload *payload)
+{
+	const char *app_version = payload->state.reported.app_version;
+	int len;
+
+	if (payload->omit || !json_plain(app_version)) {
+		return json_payload_encode(message, size, payload);
+	}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)
+	if (!json_plain(payload->state.reported.modem_version)) {
+		return json_payload_encode(message, size, payload);
+	}
+
+	len = snprintk(message, size, PAYLOAD_TEMPLATE, (int32_t)payload->state.reported.uptime,
+		       app_version, payload->state.reported.modem_version);
+#else
+	len = snprintk(message, size, PAYLOAD_TEMPLATE, (int32_t)payload->state.reported.uptime,
+		       app_version);
+#endif
+
+	if (len < 0 || len >= size) {
+		LOG_ERR("Shadow update does not fit in %zu bytes", size);
+		return -ENOMEM;
+	}
+
+	return len;
+}
+
+ssize_t json_payload_len(const struct payload *payload)
+{
+	struct payload_descr descr;
+
+	return json_calc_encoded_len(payload_descr_get(payload, &descr), ARRAY_SIZE(root),
+				     payload);
+}
+
+int json_payload_construct(char *message, size_t size, const struct payload *payload)
+{
+	PROF_SCOPE("json_payload_construct");
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_JSON_TEMPLATE)) {
+		return json_payload_template(message, size, payload);
+	}
+
+	return json_payload_encode(message, size, payload);
 }
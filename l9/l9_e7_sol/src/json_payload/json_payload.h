@@ -4,7 +4,14 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <sys/types.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+/* Fields of the reported state, in the order they are encoded. */
+#define PAYLOAD_FIELD_UPTIME	    BIT(0)
+#define PAYLOAD_FIELD_APP_VERSION   BIT(1)
+#define PAYLOAD_FIELD_MODEM_VERSION BIT(2)
 
 /* Structure used to populate and describe the JSON payload sent to AWS IoT. */
 struct payload {
@@ -15,15 +22,44 @@ struct payload {
 			uint32_t uptime;
 		} reported;
 	} state;
+	/* PAYLOAD_FIELD_* bits of the fields left out of the message, 0 to encode all of them */
+	uint32_t omit;
 };
 
 /* @brief Construct a JSON message string.
+ *
+ * Uses json_payload_template() with CONFIG_AWS_IOT_SAMPLE_JSON_TEMPLATE,
+ * json_payload_encode() otherwise.
  *
  * @param[out] message Pointer to a buffer that the JSON string is written to.
  * @param[in]  size    Size of the output buffer, message.
  * @param[in]  payload Pointer to a payload structure that will be used
  *	       to populate the JSON message.
  *
- * @return 0 on success, otherwise a negative value is returned.
+ * @return Length of the JSON string on success, otherwise a negative value is returned.
+ */
+int json_payload_construct(char *message, size_t size, const struct payload *payload);
+
+/* @brief Encode the payload with the JSON library and static descriptors.
+ *
+ * The message is appended to the buffer as it is encoded, the returned length
+ * does not need a strlen() of the result.
+ *
+ * @return Length of the JSON string on success, -ENOMEM if the buffer is too small.
+ */
+int json_payload_encode(char *message, size_t size, const struct payload *payload);
+
+/* @brief Encode the payload with a fixed format string.
+ *
+ * Gives the same output as json_payload_encode(). Falls back to it when a
+ * string needs escaping or fields are omitted.
+ *
+ * @return Length of the JSON string on success, -ENOMEM if the buffer is too small.
+ */
+int json_payload_template(char *message, size_t size, const struct payload *payload);
+
+/* @brief Get the length of the encoded payload without encoding it.
+ *
+ * @return Length of the JSON string, not including the terminator, otherwise a negative value.
  */
-int json_payload_construct(char *message, size_t size, struct payload *payload);
+ssize_t json_payload_len(const struct payload *payload);
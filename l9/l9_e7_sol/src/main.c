@@ -14,10 +14,17 @@
 #include <net/aws_iot.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <hw_id.h>
-#include <modem/modem_info.h>
 
 #include "json_payload.h"
+#include "cbor_payload.h"
+#include "reported_state.h"
+#include "device_info.h"
+#include "telemetry_queue.h"
+#include "reconnect.h"
+#include "fota_pipeline.h"
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+#include "fota_http.h"
+#endif
 
 /* Register log module */
 LOG_MODULE_REGISTER(aws_iot_sample, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
@@ -26,12 +33,17 @@ LOG_MODULE_REGISTER(aws_iot_sample, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
 #define L4_EVENT_MASK (NET_EVENT_L4_CONNECTED | NET_EVENT_L4_DISCONNECTED)
 #define CONN_LAYER_EVENT_MASK (NET_EVENT_CONN_IF_FATAL_ERROR)
 
-#define MODEM_FIRMWARE_VERSION_SIZE_MAX 50
-
 /* Application specific topics. */
 #define MY_CUSTOM_TOPIC_1 "my-custom-topic/example"
 #define MY_CUSTOM_TOPIC_2 "my-custom-topic/example_2"
 
+/* Events requesting a shadow update within this window share a single update. */
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE)
+#define SHADOW_UPDATE_COALESCE_MS CONFIG_AWS_IOT_SAMPLE_REPORTED_COALESCE_MS
+#else
+#define SHADOW_UPDATE_COALESCE_MS 0
+#endif
+
 /* Macro called upon a fatal error, reboots the device. */
 #define FATAL_ERROR()					\
 	LOG_ERR("Fatal error! Rebooting the device.");	\
@@ -42,16 +54,15 @@ LOG_MODULE_REGISTER(aws_iot_sample, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
 static struct net_mgmt_event_callback l4_cb;
 static struct net_mgmt_event_callback conn_cb;
 
-/* Variable used to store the device's hardware ID. */
-static char hw_id[HW_ID_LEN];
-
 /* Forward declarations. */
 static void shadow_update_work_fn(struct k_work *work);
+static void shadow_get_work_fn(struct k_work *work);
 static void connect_work_fn(struct k_work *work);
 static void aws_iot_event_handler(const struct aws_iot_evt *const evt);
 
 /* Work items used to control some aspects of the sample. */
 static K_WORK_DELAYABLE_DEFINE(shadow_update_work, shadow_update_work_fn);
+static K_WORK_DEFINE(shadow_get_work, shadow_get_work_fn);
 static K_WORK_DELAYABLE_DEFINE(connect_work, connect_work_fn);
 
 /* Static functions */
@@ -69,7 +80,14 @@ static int app_topics_subscribe(void)
 			.topic.utf8 = MY_CUSTOM_TOPIC_2,
 			.topic.size = strlen(MY_CUSTOM_TOPIC_2) - 1,
 			.qos = MQTT_QOS_1_AT_LEAST_ONCE,
-		}
+		},
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+		{
+			.topic.utf8 = CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_TOPIC,
+			.topic.size = sizeof(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_TOPIC) - 1,
+			.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		},
+#endif
 	};
 
 	err = aws_iot_application_topics_set(topic_list, ARRAY_SIZE(topic_list));
@@ -82,6 +100,17 @@ static int app_topics_subscribe(void)
 	return 0;
 }
 
+/* Send a shadow update after the coalescing window, unless one is due sooner. */
+static void shadow_update_request(void)
+{
+	k_timeout_t delay = K_MSEC(SHADOW_UPDATE_COALESCE_MS);
+
+	if (!k_work_delayable_is_pending(&shadow_update_work) ||
+	    k_work_delayable_remaining_get(&shadow_update_work) > delay.ticks) {
+		(void)k_work_reschedule(&shadow_update_work, delay);
+	}
+}
+
 static int aws_iot_client_init(void)
 {
 	int err;
@@ -110,42 +139,57 @@ static int aws_iot_client_init(void)
 
 static void shadow_update_work_fn(struct k_work *work)
 {
+	/* Kept off the system workqueue stack, only used from this work item */
+	static char message[CONFIG_AWS_IOT_SAMPLE_JSON_MESSAGE_SIZE_MAX];
 	int err;
-	char message[CONFIG_AWS_IOT_SAMPLE_JSON_MESSAGE_SIZE_MAX] = { 0 };
+	int len;
+	const struct device_info *info = device_info_get();
 	struct payload payload = {
 		.state.reported.uptime = k_uptime_get(),
-		.state.reported.app_version = CONFIG_AWS_IOT_SAMPLE_APP_VERSION,
+		.state.reported.app_version = info->app_version,
+		.state.reported.modem_version = info->modem_fw,
 	};
 	struct aws_iot_data tx_data = {
 		.qos = MQTT_QOS_0_AT_MOST_ONCE,
 		.topic.type = AWS_IOT_SHADOW_TOPIC_UPDATE,
 	};
 
-	if (IS_ENABLED(CONFIG_MODEM_INFO)) {
-		char modem_version_temp[MODEM_FIRMWARE_VERSION_SIZE_MAX];
-
-		err = modem_info_get_fw_version(modem_version_temp,
-						ARRAY_SIZE(modem_version_temp));
-		if (err) {
-			LOG_ERR("modem_info_get_fw_version, error: %d", err);
-			FATAL_ERROR();
-			return;
-		}
+	/* Leave out what the shadow already has */
+	if (reported_state_diff(&payload) == 0) {
+		LOG_INF("Reported state unchanged, no shadow update");
+		(void)k_work_reschedule(&shadow_update_work,
+				K_SECONDS(CONFIG_AWS_IOT_SAMPLE_PUBLICATION_INTERVAL_SECONDS));
+		return;
+	}
 
-		payload.state.reported.modem_version = modem_version_temp;
+#if defined(CONFIG_AWS_IOT_SAMPLE_CBOR_PAYLOAD)
+	len = cbor_payload_construct((uint8_t *)message, sizeof(message), &payload);
+	if (len < 0) {
+		LOG_ERR("cbor_payload_construct, error: %d", len);
+		FATAL_ERROR();
+		return;
 	}
 
-	err = json_payload_construct(message, sizeof(message), &payload);
-	if (err) {
-		LOG_ERR("json_payload_construct, error: %d", err);
+	/* The shadow only accepts JSON, a cloud rule forwards this topic to it */
+	tx_data.topic.type = AWS_IOT_SHADOW_TOPIC_NONE;
+	tx_data.topic.str = CONFIG_AWS_IOT_SAMPLE_CBOR_TOPIC;
+	tx_data.topic.len = strlen(CONFIG_AWS_IOT_SAMPLE_CBOR_TOPIC);
+
+	LOG_INF("Publishing %d bytes of CBOR to %s", len, CONFIG_AWS_IOT_SAMPLE_CBOR_TOPIC);
+	LOG_HEXDUMP_DBG(message, len, "Shadow update");
+#else
+	len = json_payload_construct(message, sizeof(message), &payload);
+	if (len < 0) {
+		LOG_ERR("json_payload_construct, error: %d", len);
 		FATAL_ERROR();
 		return;
 	}
 
-	tx_data.ptr = message;
-	tx_data.len = strlen(message);
+	LOG_INF("Publishing message: %.*s to AWS IoT shadow", len, message);
+#endif
 
-	LOG_INF("Publishing message: %s to AWS IoT shadow", message);
+	tx_data.ptr = message;
+	tx_data.len = len;
 
 	err = aws_iot_send(&tx_data);
 	if (err) {
@@ -158,26 +202,270 @@ static void shadow_update_work_fn(struct k_work *work)
 				K_SECONDS(CONFIG_AWS_IOT_SAMPLE_PUBLICATION_INTERVAL_SECONDS));
 }
 
+static void shadow_get_work_fn(struct k_work *work)
+{
+	int err;
+	struct aws_iot_data tx_data = {
+		.qos = MQTT_QOS_0_AT_MOST_ONCE,
+		.topic.type = AWS_IOT_SHADOW_TOPIC_GET,
+		.ptr = "",
+		.len = 0,
+	};
+
+	/* The reported state arrives on get/accepted */
+	err = aws_iot_send(&tx_data);
+	if (err) {
+		LOG_WRN("Shadow get request failed, error: %d", err);
+	}
+}
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE)
+static int telemetry_publish(const uint8_t *data, size_t len, uint16_t message_id)
+{
+	struct aws_iot_data tx_data = {
+		.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		.message_id = message_id,
+		.ptr = (char *)data,
+		.len = len,
+		.topic.type = AWS_IOT_SHADOW_TOPIC_NONE,
+		.topic.str = CONFIG_AWS_IOT_SAMPLE_TELEMETRY_TOPIC,
+		.topic.len = strlen(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_TOPIC),
+	};
+
+	return aws_iot_send(&tx_data);
+}
+
+/* Produces records whether connected or not, the queue keeps them until they are sent */
+static void telemetry_work_fn(struct k_work *work)
+{
+	char record[32];
+	int len;
+	int err;
+
+	len = snprintk(record, sizeof(record), "{\"uptime\":%u}", (uint32_t)k_uptime_get());
+
+	err = telemetry_queue_append(record, len);
+	if (err) {
+		LOG_WRN("telemetry_queue_append, error: %d", err);
+	}
+
+	(void)k_work_reschedule(k_work_delayable_from_work(work),
+				K_SECONDS(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_INTERVAL_SECONDS));
+}
+
+static K_WORK_DELAYABLE_DEFINE(telemetry_work, telemetry_work_fn);
+#endif /* CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE */
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+static struct fota_http fota_http;
+static K_MUTEX_DEFINE(fota_lock);
+
+/* Transient failures of the current download, reset by a new request */
+static atomic_t fota_retries;
+
+/* URL of the running download, an interrupted patch leaves no checkpoint with it */
+static char fota_url[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+
+static void fota_resume_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(fota_resume_work, fota_resume_work_fn);
+
+/* Transient errors of a download, anything else will fail again */
+static bool fota_error_is_transient(int err)
+{
+	switch (err) {
+	case -EAGAIN:
+	case -ETIMEDOUT:
+	case -EIO:
+	case -ENOMEM:
+	case -EPIPE:
+	case -ECONNABORTED:
+	case -ECONNREFUSED:
+	case -ECONNRESET:
+	case -ENOTCONN:
+	case -ENETDOWN:
+	case -ENETUNREACH:
+	case -EHOSTDOWN:
+	case -EHOSTUNREACH:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Report a download that will not be retried and forget its checkpoint */
+static void fota_fail(const char *url, int err)
+{
+	char message[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 64];
+	struct aws_iot_data tx_data = {
+		.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		.topic.type = AWS_IOT_SHADOW_TOPIC_NONE,
+		.topic.str = CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_STATUS_TOPIC,
+		.topic.len = strlen(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_STATUS_TOPIC),
+	};
+	int len;
+	int ret;
+
+	LOG_ERR("Download of %s failed, error: %d", url, err);
+
+	ret = fota_pipeline_clear();
+	if (ret) {
+		LOG_WRN("fota_pipeline_clear, error: %d", ret);
+	}
+
+	len = snprintk(message, sizeof(message), "{\"url\":\"%s\",\"status\":\"FAILED\","
+		       "\"error\":%d}", url, err);
+	if (len < 0 || len >= sizeof(message)) {
+		return;
+	}
+
+	tx_data.ptr = message;
+	tx_data.len = len;
+
+	ret = aws_iot_send(&tx_data);
+	if (ret) {
+		LOG_WRN("Download status not sent, error: %d", ret);
+	}
+}
+
+static int fota_download(const char *url, uint32_t size)
+{
+	int err;
+
+	k_mutex_lock(&fota_lock, K_FOREVER);
+
+	if (fota_pipeline_busy()) {
+		err = -EBUSY;
+	} else {
+		err = fota_http_init(&fota_http, url);
+		if (!err) {
+			snprintk(fota_url, sizeof(fota_url), "%s", url);
+			err = fota_pipeline_start(url, size, fota_http_fetch, &fota_http);
+		}
+	}
+
+	k_mutex_unlock(&fota_lock);
+
+	if (err) {
+		LOG_WRN("Image download not started, error: %d", err);
+	}
+
+	return err;
+}
+
+/* Continue an interrupted download from its checkpoint */
+static void fota_resume_work_fn(struct k_work *work)
+{
+	char url[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+	uint32_t size;
+	uint32_t offset;
+	int err;
+
+	if (fota_pipeline_pending(url, sizeof(url), &size, &offset) == 0) {
+		err = fota_download(url, size);
+		if (err && err != -EBUSY && !fota_error_is_transient(err)) {
+			fota_fail(url, err);
+		}
+	}
+}
+
+static void fota_request_handle(const struct aws_iot_evt *const evt)
+{
+	char msg[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 32];
+	const char *url;
+	uint32_t size;
+
+	if (evt->data.msg.len >= sizeof(msg)) {
+		LOG_WRN("Download request too long");
+		return;
+	}
+
+	memcpy(msg, evt->data.msg.ptr, evt->data.msg.len);
+	msg[evt->data.msg.len] = '\0';
+
+	if (fota_http_request_parse(msg, evt->data.msg.len, &url, &size)) {
+		LOG_WRN("Invalid download request");
+		return;
+	}
+
+	if (fota_download(url, size) == 0) {
+		atomic_clear(&fota_retries);
+	}
+}
+
+/* Called from the writer thread of the pipeline */
+static void fota_pipeline_done(int err)
+{
+	char url[CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_ID_LEN_MAX + 1];
+	uint32_t size;
+	uint32_t offset;
+
+	fota_http_close(&fota_http);
+
+	if (err && fota_pipeline_pending(url, sizeof(url), &size, &offset) != 0) {
+		/* A patch is not resumed, it has to be requested again */
+		atomic_clear(&fota_retries);
+		fota_fail(fota_url, err);
+		return;
+	} else if (err == -ECANCELED) {
+		/* Stopped on a disconnection, resumed once connected again */
+		return;
+	} else if (err && fota_error_is_transient(err) &&
+		   atomic_inc(&fota_retries) < CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_RETRIES) {
+		LOG_WRN("Download interrupted, retry %d of %d", (int)atomic_get(&fota_retries),
+			CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_RETRIES);
+		(void)k_work_reschedule(&fota_resume_work,
+				K_SECONDS(CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS));
+		return;
+	}
+
+	atomic_clear(&fota_retries);
+
+	if (err) {
+		fota_fail(url, err);
+		return;
+	}
+
+#if defined(CONFIG_BOOTLOADER_MCUBOOT)
+	err = boot_request_upgrade(BOOT_UPGRADE_TEST);
+	if (err) {
+		LOG_ERR("boot_request_upgrade, error: %d", err);
+		return;
+	}
+#endif
+
+	LOG_INF("Image downloaded, rebooting");
+	(void)aws_iot_disconnect();
+	IF_ENABLED(CONFIG_REBOOT, (sys_reboot(0)));
+}
+#endif /* CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP */
+
+/* Drops the connection to measure what reconnecting costs, see the reconnect counters. */
+static void reconnect_test_work_fn(struct k_work *work)
+{
+	LOG_INF("Disconnecting to measure the reconnection");
+	(void)aws_iot_disconnect();
+}
+
+static K_WORK_DELAYABLE_DEFINE(reconnect_test_work, reconnect_test_work_fn);
+
 static void connect_work_fn(struct k_work *work)
 {
 	int err;
 	const struct aws_iot_config config = {
-		.client_id = hw_id,
+		.client_id = device_info_get()->hw_id,
 	};
 
 	LOG_INF("Connecting to AWS IoT");
 
+	reconnect_attempt_begin();
 	err = aws_iot_connect(&config);
-	if (err == -EAGAIN) {
-		LOG_INF("Connection attempt timed out, "
-			"Next connection retry in %d seconds",
-			CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS);
+	reconnect_attempt_end(err);
 
-		(void)k_work_reschedule(&connect_work,
-				K_SECONDS(CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS));
-	} else if (err) {
-		LOG_ERR("aws_iot_connect, error: %d", err);
-		FATAL_ERROR();
+	/* Back off on every error, rebooting would only add to the load of a failing broker */
+	if (err) {
+		LOG_WRN("aws_iot_connect, error: %d", err);
+		(void)k_work_reschedule(&connect_work, reconnect_delay());
 	}
 }
 
@@ -186,6 +474,7 @@ static void connect_work_fn(struct k_work *work)
 static void on_aws_iot_evt_connected(const struct aws_iot_evt *const evt)
 {
 	(void)k_work_cancel_delayable(&connect_work);
+	reconnect_connected(evt->data.persistent_session);
 
 	/* If persistent session is enabled, the AWS IoT library will not subscribe to any topics.
 	 * Topics from the last session will be used.
@@ -201,14 +490,34 @@ static void on_aws_iot_evt_connected(const struct aws_iot_evt *const evt)
 	boot_write_img_confirmed();
 #endif
 
+	/* Fetch the reported state so that the first update only carries what changed */
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE)) {
+		(void)k_work_submit(&shadow_get_work);
+	}
+
 	/* Start sequential updates to AWS IoT. */
-	(void)k_work_reschedule(&shadow_update_work, K_NO_WAIT);
+	shadow_update_request();
+
+	/* Send the telemetry stored while offline */
+	telemetry_queue_set_online(true);
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+	(void)k_work_reschedule(&fota_resume_work, K_NO_WAIT);
+#endif
+
+	if (CONFIG_AWS_IOT_SAMPLE_RECONNECT_TEST_SECONDS > 0) {
+		(void)k_work_reschedule(&reconnect_test_work,
+					K_SECONDS(CONFIG_AWS_IOT_SAMPLE_RECONNECT_TEST_SECONDS));
+	}
 }
 
 static void on_aws_iot_evt_disconnected(void)
 {
+	telemetry_queue_set_online(false);
 	(void)k_work_cancel_delayable(&shadow_update_work);
-	(void)k_work_reschedule(&connect_work, K_SECONDS(5));
+	(void)k_work_cancel_delayable(&reconnect_test_work);
+	reconnect_dropped();
+	(void)k_work_reschedule(&connect_work, reconnect_delay());
 }
 
 static void on_aws_iot_evt_fota_done(const struct aws_iot_evt *const evt)
@@ -239,6 +548,9 @@ static void on_aws_iot_evt_fota_done(const struct aws_iot_evt *const evt)
 			return;
 		}
 
+		/* The modem firmware version changed */
+		(void)device_info_refresh();
+
 		err = conn_mgr_all_if_connect(true);
 		if (err) {
 			LOG_ERR("conn_mgr_all_if_connect, error: %d", err);
@@ -256,7 +568,8 @@ static void on_aws_iot_evt_fota_done(const struct aws_iot_evt *const evt)
 
 static void on_net_event_l4_connected(void)
 {
-	(void)k_work_reschedule(&connect_work, K_SECONDS(5));
+	/* Nothing failed yet, the backoff only starts with a failed attempt */
+	(void)k_work_reschedule(&connect_work, reconnect_delay_link_up());
 }
 
 static void on_net_event_l4_disconnected(void)
@@ -264,6 +577,9 @@ static void on_net_event_l4_disconnected(void)
 	(void)aws_iot_disconnect();
 	(void)k_work_cancel_delayable(&connect_work);
 	(void)k_work_cancel_delayable(&shadow_update_work);
+	(void)k_work_cancel_delayable(&reconnect_test_work);
+	telemetry_queue_set_online(false);
+	fota_pipeline_stop();
 }
 
 /* Event handlers */
@@ -289,9 +605,25 @@ static void aws_iot_event_handler(const struct aws_iot_evt *const evt)
 									 evt->data.msg.ptr,
 									 evt->data.msg.topic.len,
 									 evt->data.msg.topic.str);
+
+		if (evt->data.msg.topic.type == AWS_IOT_SHADOW_TOPIC_GET_ACCEPTED) {
+			(void)reported_state_ack(evt->data.msg.ptr, evt->data.msg.len, true);
+			shadow_update_request();
+		} else if (evt->data.msg.topic.type == AWS_IOT_SHADOW_TOPIC_UPDATE_ACCEPTED) {
+			(void)reported_state_ack(evt->data.msg.ptr, evt->data.msg.len, false);
+		}
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+		else if (evt->data.msg.topic.len ==
+				sizeof(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_TOPIC) - 1 &&
+			 !strncmp(evt->data.msg.topic.str, CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_TOPIC,
+				  evt->data.msg.topic.len)) {
+			fota_request_handle(evt);
+		}
+#endif
 		break;
 	case AWS_IOT_EVT_PUBACK:
 		LOG_INF("AWS_IOT_EVT_PUBACK, message ID: %d", evt->data.message_id);
+		(void)telemetry_queue_ack(evt->data.message_id);
 		break;
 	case AWS_IOT_EVT_PINGRESP:
 		LOG_INF("AWS_IOT_EVT_PINGRESP");
@@ -381,6 +713,31 @@ int main(void)
 		return err;
 	}
 
+	/* Read the device identity once the modem is initialized, a failure leaves empty fields */
+	(void)device_info_refresh();
+	reconnect_init(device_info_get()->hw_id);
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE)
+	err = telemetry_queue_init(telemetry_publish);
+	if (err) {
+		LOG_ERR("telemetry_queue_init, error: %d", err);
+		FATAL_ERROR();
+		return err;
+	}
+
+	(void)k_work_schedule(&telemetry_work, K_NO_WAIT);
+#endif
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_FOTA_PIPELINE_HTTP)
+	/* An interrupted download is resumed once connected */
+	err = fota_pipeline_init(fota_pipeline_done);
+	if (err) {
+		LOG_ERR("fota_pipeline_init, error: %d", err);
+		FATAL_ERROR();
+		return err;
+	}
+#endif
+
 		err = conn_mgr_all_if_connect(true);
 	if (err) {
 		LOG_ERR("conn_mgr_all_if_connect, error: %d", err);
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Reconnection scheduler: capped exponential backoff with jitter.
+ *
+ * After a broker outage every device of the fleet sees its connection fail
+ * at about the same time. A fixed retry period keeps them in step, drawing
+ * each delay between half and all of the backoff step from a generator
+ * seeded with the hardware ID spreads them out.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_AWS_IOT_SAMPLE_RECONNECT_BYTES)
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_stats.h>
+#endif
+
+#include "reconnect.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(reconnect, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define BACKOFF_MIN_MS	  (CONFIG_AWS_IOT_SAMPLE_CONNECTION_RETRY_TIMEOUT_SECONDS * MSEC_PER_SEC)
+#define BACKOFF_MAX_MS	  (CONFIG_AWS_IOT_SAMPLE_RECONNECT_BACKOFF_MAX_SECONDS * MSEC_PER_SEC)
+#define FAST_MS		  CONFIG_AWS_IOT_SAMPLE_RECONNECT_FAST_MS
+#define STABLE_MS	  (CONFIG_AWS_IOT_SAMPLE_RECONNECT_STABLE_SECONDS * MSEC_PER_SEC)
+
+static struct {
+	uint32_t rng;
+	uint32_t backoff_ms;
+	bool fast;
+	int64_t attempt_start;
+	uint32_t attempts;
+	int64_t connected_at;
+	uint32_t bytes_sent;
+	uint32_t bytes_received;
+	struct reconnect_stats stats;
+} rc;
+
+static K_SPINLOCK_DEFINE(rc_lock);
+
+/* xorshift32, never seeded with 0 */
+static uint32_t rng_next(void)
+{
+	rc.rng ^= rc.rng << 13;
+	rc.rng ^= rc.rng >> 17;
+	rc.rng ^= rc.rng << 5;
+
+	return rc.rng;
+}
+
+/* Between half and all of ms */
+static uint32_t jitter(uint32_t ms)
+{
+	return ms / 2 + rng_next() % (ms / 2 + 1);
+}
+
+static void bytes_get(uint32_t *sent, uint32_t *received)
+{
+#if defined(CONFIG_AWS_IOT_SAMPLE_RECONNECT_BYTES)
+	struct net_stats_bytes bytes;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_BYTES, net_if_get_default(), &bytes,
+		     sizeof(bytes)) == 0) {
+		*sent = bytes.sent;
+		*received = bytes.received;
+		return;
+	}
+#endif
+	*sent = 0;
+	*received = 0;
+}
+
+void reconnect_init(const char *device_id)
+{
+	/* FNV-1a of the hardware ID */
+	uint32_t hash = 2166136261U;
+
+	for (const char *c = device_id; *c != '\0'; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619U;
+	}
+
+	K_SPINLOCK(&rc_lock) {
+		rc.rng = hash ? hash : 1;
+		rc.backoff_ms = BACKOFF_MIN_MS;
+	}
+}
+
+/* FAST_MS plus up to as much jitter, called with rc_lock held */
+static uint32_t fast_delay(void)
+{
+	return FAST_MS + rng_next() % (FAST_MS + 1);
+}
+
+k_timeout_t reconnect_delay_link_up(void)
+{
+	uint32_t delay_ms;
+
+	K_SPINLOCK(&rc_lock) {
+		delay_ms = fast_delay();
+	}
+
+	LOG_INF("Network up, connection attempt in %u ms", delay_ms);
+
+	return K_MSEC(delay_ms);
+}
+
+k_timeout_t reconnect_delay(void)
+{
+	uint32_t delay_ms;
+
+	K_SPINLOCK(&rc_lock) {
+		if (rc.fast) {
+			rc.fast = false;
+			delay_ms = fast_delay();
+		} else {
+			delay_ms = jitter(rc.backoff_ms);
+			rc.backoff_ms = MIN(rc.backoff_ms * 2, BACKOFF_MAX_MS);
+		}
+	}
+
+	LOG_INF("Next connection attempt in %u ms", delay_ms);
+
+	return K_MSEC(delay_ms);
+}
+
+void reconnect_attempt_begin(void)
+{
+	uint32_t sent;
+	uint32_t received;
+
+	bytes_get(&sent, &received);
+
+	K_SPINLOCK(&rc_lock) {
+		rc.attempt_start = k_uptime_get();
+		rc.bytes_sent = sent;
+		rc.bytes_received = received;
+		rc.stats.attempts++;
+		rc.attempts++;
+	}
+}
+
+void reconnect_attempt_end(int err)
+{
+	K_SPINLOCK(&rc_lock) {
+		uint32_t ms = k_uptime_get() - rc.attempt_start;
+
+		rc.stats.handshake_ms_last = ms;
+		rc.stats.handshake_ms_total += ms;
+		if (err) {
+			rc.stats.failures++;
+		}
+	}
+}
+
+void reconnect_connected(bool persistent_session)
+{
+	struct reconnect_stats stats;
+	uint32_t attempts;
+	uint32_t sent;
+	uint32_t received;
+
+	bytes_get(&sent, &received);
+
+	K_SPINLOCK(&rc_lock) {
+		rc.connected_at = k_uptime_get();
+		rc.backoff_ms = BACKOFF_MIN_MS;
+		rc.fast = false;
+
+		rc.stats.connects++;
+		rc.stats.connect_ms_last = rc.connected_at - rc.attempt_start;
+		rc.stats.bytes_sent_last = sent - rc.bytes_sent;
+		rc.stats.bytes_received_last = received - rc.bytes_received;
+		rc.stats.bytes_total += rc.stats.bytes_sent_last + rc.stats.bytes_received_last;
+		if (rc.stats.connects == 1) {
+			rc.stats.connect_ms_first = rc.stats.connect_ms_last;
+			rc.stats.bytes_first = rc.stats.bytes_sent_last +
+					       rc.stats.bytes_received_last;
+		}
+		if (persistent_session) {
+			rc.stats.persistent_sessions++;
+		}
+		stats = rc.stats;
+		attempts = rc.attempts;
+		rc.attempts = 0;
+	}
+
+	LOG_INF("Connected after %u attempts: handshake %u ms, connected in %u ms, "
+		"%u bytes sent, %u received", attempts, stats.handshake_ms_last,
+		stats.connect_ms_last, stats.bytes_sent_last, stats.bytes_received_last);
+
+	if (stats.connects > 1) {
+		LOG_INF("Reconnection %u: %u ms and %u bytes, first connection %u ms and %u bytes, "
+			"%s session", stats.connects - 1, stats.connect_ms_last,
+			stats.bytes_sent_last + stats.bytes_received_last,
+			stats.connect_ms_first, stats.bytes_first,
+			persistent_session ? "persistent" : "clean");
+	}
+}
+
+void reconnect_dropped(void)
+{
+	K_SPINLOCK(&rc_lock) {
+		rc.fast = rc.connected_at && k_uptime_get() - rc.connected_at >= STABLE_MS;
+		rc.connected_at = 0;
+	}
+}
+
+void reconnect_stats_get(struct reconnect_stats *stats)
+{
+	K_SPINLOCK(&rc_lock) {
+		*stats = rc.stats;
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RECONNECT_H_
+#define RECONNECT_H_
+
+#include <zephyr/kernel.h>
+
+/* Cost of the connections since reconnect_init(). */
+struct reconnect_stats {
+	/* Connection attempts, and the ones that reached AWS_IOT_EVT_CONNECTED. */
+	uint32_t attempts;
+	uint32_t connects;
+	/* Attempts where aws_iot_connect() returned an error. */
+	uint32_t failures;
+	/* Time spent in aws_iot_connect(), covering DNS, TCP and the TLS handshake. */
+	uint32_t handshake_ms_last;
+	uint32_t handshake_ms_total;
+	/* Time from the start of the attempt to AWS_IOT_EVT_CONNECTED. */
+	uint32_t connect_ms_last;
+	/* Bytes exchanged from the start of the attempt to AWS_IOT_EVT_CONNECTED,
+	 * 0 without CONFIG_AWS_IOT_SAMPLE_RECONNECT_BYTES.
+	 */
+	uint32_t bytes_sent_last;
+	uint32_t bytes_received_last;
+	uint32_t bytes_total;
+	/* The same for the first connection after reconnect_init(), which never
+	 * resumes a TLS session, to compare the later ones with.
+	 */
+	uint32_t connect_ms_first;
+	uint32_t bytes_first;
+	/* Connections where the broker kept the MQTT session. */
+	uint32_t persistent_sessions;
+};
+
+/* @brief Seed the jitter of the delays.
+ *
+ * @param[in] device_id String unique to the device, the hardware ID.
+ */
+void reconnect_init(const char *device_id);
+
+/* @brief Get the delay before the first connection attempt once the network is up.
+ *
+ * The fast delay, the backoff is left as it is.
+ */
+k_timeout_t reconnect_delay_link_up(void);
+
+/* @brief Get the delay before the next connection attempt after a failed one or a drop.
+ *
+ * The fast delay after a transient drop, otherwise the current step of the
+ * backoff, which then doubles.
+ */
+k_timeout_t reconnect_delay(void);
+
+/* @brief Call before aws_iot_connect(). */
+void reconnect_attempt_begin(void);
+
+/* @brief Call after aws_iot_connect() returned. */
+void reconnect_attempt_end(int err);
+
+/* @brief Call on AWS_IOT_EVT_CONNECTED, resets the backoff.
+ *
+ * @param[in] persistent_session True if the broker kept the MQTT session.
+ */
+void reconnect_connected(bool persistent_session);
+
+/* @brief Call when the connection is lost.
+ *
+ * The next delay is the fast one if the connection was stable.
+ */
+void reconnect_dropped(void);
+
+/* @brief Get the connection counters. */
+void reconnect_stats_get(struct reconnect_stats *stats);
+
+#endif /* RECONNECT_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Reported state acknowledged by the shadow service.
+ *
+ * get/accepted replaces the cache with the reported state of the shadow,
+ * update/accepted merges the fields of the accepted update into it. Both
+ * arrive on the MQTT helper thread while shadow updates are built on the
+ * system workqueue, so the cache is protected by a mutex.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/data/json.h>
+
+#include "reported_state.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(reported_state, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+#define STRING_MAX	 CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE_STRING_MAX
+#define UPTIME_DEADBAND (CONFIG_AWS_IOT_SAMPLE_REPORTED_UPTIME_DEADBAND * MSEC_PER_SEC)
+
+/* Uptime is decoded as a signed 32-bit number, the shadow never holds -1 */
+#define UPTIME_NONE	 UINT32_MAX
+
+static const struct json_obj_descr parameters[] = {
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "uptime",
+				  state.reported.uptime, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "app_version",
+				  state.reported.app_version, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM_NAMED(struct payload, "modem_version",
+				  state.reported.modem_version, JSON_TOK_STRING),
+};
+
+static const struct json_obj_descr reported[] = {
+	JSON_OBJ_DESCR_OBJECT_NAMED(struct payload, "reported", state.reported,
+				    parameters),
+};
+
+static const struct json_obj_descr root[] = {
+	JSON_OBJ_DESCR_OBJECT(struct payload, state, reported),
+};
+
+static struct {
+	/* PAYLOAD_FIELD_* bits of the fields below that hold the shadow value */
+	uint32_t known;
+	uint32_t uptime;
+	char app_version[STRING_MAX];
+	char modem_version[STRING_MAX];
+} acked;
+
+static K_MUTEX_DEFINE(acked_lock);
+
+/* json_obj_parse() decodes in place */
+static char doc_buf[CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE_DOC_SIZE_MAX];
+
+static void string_ack(char *dst, const char *src, uint32_t field)
+{
+	if (src == NULL) {
+		return;
+	}
+
+	if (strlen(src) >= STRING_MAX) {
+		acked.known &= ~field;
+		return;
+	}
+
+	strcpy(dst, src);
+	acked.known |= field;
+}
+
+static bool string_known(const char *cached, const char *value, uint32_t field)
+{
+	return (acked.known & field) && value != NULL && strcmp(cached, value) == 0;
+}
+
+int reported_state_ack(const char *doc, size_t len, bool full)
+{
+	struct payload parsed = {
+		.state.reported.uptime = UPTIME_NONE,
+	};
+	int ret;
+
+	if (len >= sizeof(doc_buf)) {
+		LOG_WRN("Shadow document of %zu bytes ignored", len);
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&acked_lock, K_FOREVER);
+
+	memcpy(doc_buf, doc, len);
+	doc_buf[len] = '\0';
+
+	ret = json_obj_parse(doc_buf, len, root, ARRAY_SIZE(root), &parsed);
+	if (ret < 0) {
+		LOG_WRN("json_obj_parse, error: %d", ret);
+		goto out;
+	}
+
+	if (full) {
+		acked.known = 0;
+	}
+
+	if (parsed.state.reported.uptime != UPTIME_NONE) {
+		acked.uptime = parsed.state.reported.uptime;
+		acked.known |= PAYLOAD_FIELD_UPTIME;
+	}
+
+	string_ack(acked.app_version, parsed.state.reported.app_version,
+		   PAYLOAD_FIELD_APP_VERSION);
+	string_ack(acked.modem_version, parsed.state.reported.modem_version,
+		   PAYLOAD_FIELD_MODEM_VERSION);
+
+	LOG_DBG("Acknowledged fields: 0x%x", acked.known);
+	ret = 0;
+
+out:
+	k_mutex_unlock(&acked_lock);
+
+	return ret;
+}
+
+int reported_state_diff(struct payload *payload)
+{
+	uint32_t fields = PAYLOAD_FIELD_UPTIME | PAYLOAD_FIELD_APP_VERSION;
+
+	if (IS_ENABLED(CONFIG_AWS_IOT_SAMPLE_REPORT_MODEM_VERSION)) {
+		fields |= PAYLOAD_FIELD_MODEM_VERSION;
+	}
+
+	k_mutex_lock(&acked_lock, K_FOREVER);
+
+	/* A deadband of 0 still leaves out an unchanged uptime */
+	if ((acked.known & PAYLOAD_FIELD_UPTIME) &&
+	    abs((int32_t)(payload->state.reported.uptime - acked.uptime)) <
+		    MAX(UPTIME_DEADBAND, 1)) {
+		payload->omit |= PAYLOAD_FIELD_UPTIME;
+	}
+
+	if (string_known(acked.app_version, payload->state.reported.app_version,
+			 PAYLOAD_FIELD_APP_VERSION)) {
+		payload->omit |= PAYLOAD_FIELD_APP_VERSION;
+	}
+
+	if (string_known(acked.modem_version, payload->state.reported.modem_version,
+			 PAYLOAD_FIELD_MODEM_VERSION)) {
+		payload->omit |= PAYLOAD_FIELD_MODEM_VERSION;
+	}
+
+	k_mutex_unlock(&acked_lock);
+
+	return __builtin_popcount(fields & ~payload->omit);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef REPORTED_STATE_H_
+#define REPORTED_STATE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+#include "json_payload.h"
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE)
+
+/* @brief Leave out of the payload the fields the shadow already has.
+ *
+ * Sets payload->omit for every field equal to its acknowledged value, or
+ * within the deadband of it for uptime.
+ *
+ * @param[in,out] payload Payload about to be sent.
+ *
+ * @return Number of fields left to send, 0 if the update can be skipped.
+ */
+int reported_state_diff(struct payload *payload);
+
+/* @brief Record the reported state of an accepted shadow document.
+ *
+ * @param[in] doc  Document received on get/accepted or update/accepted.
+ * @param[in] len  Length of the document.
+ * @param[in] full True for get/accepted, where fields missing from the
+ *		   document are not in the shadow either.
+ *
+ * @return 0 on success, -ENOMEM if the document is too large, otherwise a negative value.
+ */
+int reported_state_ack(const char *doc, size_t len, bool full);
+
+#else
+
+static inline int reported_state_diff(struct payload *payload)
+{
+	return 1;
+}
+
+static inline int reported_state_ack(const char *doc, size_t len, bool full)
+{
+	return 0;
+}
+
+#endif /* CONFIG_AWS_IOT_SAMPLE_REPORTED_STATE */
+
+#endif /* REPORTED_STATE_H_ */
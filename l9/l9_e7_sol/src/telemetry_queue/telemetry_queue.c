@@ -0,0 +1,642 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Store and forward telemetry queue on a flash circular buffer.
+ *
+ * Records are gathered in RAM and appended to the FCB as one entry holding
+ * [uint16_t length][data] records, zero padded to the write block size.
+ * The FCB writes sectors in turn, which spreads the wear over the partition.
+ *
+ * While online, up to CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_WINDOW messages are
+ * published and waiting for their PUBACK, and published again with a new
+ * message ID when it does not come in time. With the batcher, a message is a
+ * JSON array of the records that fit in it, sent once full or once the
+ * latency budget has run out. Otherwise it is a single record.
+ *
+ * The head is the oldest record not acknowledged: the oldest sector is erased
+ * once the head has left it.
+ * Progress within a sector is not stored, so the acknowledged records of the
+ * oldest sector are published again after a reset. Delivery is at least once,
+ * as with QoS 1.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "telemetry_queue.h"
+
+/* Register log module */
+LOG_MODULE_REGISTER(telemetry_queue, CONFIG_AWS_IOT_SAMPLE_LOG_LEVEL);
+
+/* The queue erases the partition, it must not be shared with settings or anything else */
+#if !FIXED_PARTITION_EXISTS(telemetry_partition)
+#error "The telemetry queue needs a telemetry_partition partition"
+#endif
+#define TELEMETRY_PARTITION_ID FIXED_PARTITION_ID(telemetry_partition)
+
+#define TELEMETRY_FCB_MAGIC	0x544c4d31 /* "TLM1" */
+#define BATCH_SIZE		CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_BATCH_SIZE
+#define WINDOW			CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_WINDOW
+#define ACK_TIMEOUT_MS		CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_ACK_TIMEOUT_MS
+#define PUBLISH_RETRY_MS	1000
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_BATCHER)
+#define BATCHER			1
+#define MESSAGE_SIZE		CONFIG_AWS_IOT_SAMPLE_TELEMETRY_BATCHER_MESSAGE_SIZE
+#define LATENCY_MS		CONFIG_AWS_IOT_SAMPLE_TELEMETRY_BATCHER_LATENCY_MS
+/* Brackets of the JSON array */
+#define MESSAGE_OVERHEAD	2
+#else
+#define BATCHER			0
+#define MESSAGE_SIZE		BATCH_SIZE
+#define LATENCY_MS		0
+#define MESSAGE_OVERHEAD	0
+#endif
+#define RECORD_HDR_SIZE		sizeof(uint16_t)
+
+/* Above the IDs the MQTT helper hands out for its own requests */
+#define MSG_ID_FIRST		0x8000
+
+/* Largest write block size of the DKs */
+#define WRITE_BLOCK_MAX		16
+
+/* Position of a record, fe_sector is NULL before the first entry */
+struct cursor {
+	struct fcb_entry entry;
+	uint16_t off;
+};
+
+/* Published message holding count records from pos */
+struct inflight {
+	struct cursor pos;
+	size_t count;
+	int64_t sent_at;
+	uint16_t message_id;
+	bool acked;
+};
+
+static struct {
+	struct fcb fcb;
+	struct flash_sector sectors[CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_SECTORS_MAX];
+	telemetry_queue_publish_t publish;
+	bool online;
+
+	/* Oldest record not acknowledged, and next record to publish */
+	struct cursor head;
+	struct cursor read;
+
+	/* Published messages in publication order */
+	struct inflight window[WINDOW];
+	size_t window_start;
+	size_t window_count;
+	uint16_t next_message_id;
+
+	/* Time a partial message is sent at, 0 when there is none waiting */
+	int64_t batch_deadline;
+
+	uint8_t staging[BATCH_SIZE + WRITE_BLOCK_MAX];
+	size_t staged;
+
+	struct telemetry_queue_stats stats;
+} q;
+
+static K_MUTEX_DEFINE(queue_lock);
+
+/* Used by the drain work item only */
+static uint8_t message_buf[MESSAGE_SIZE];
+
+static void drain_work_fn(struct k_work *work);
+static void flush_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(drain_work, drain_work_fn);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_fn);
+
+static struct inflight *window_at(size_t i)
+{
+	return &q.window[(q.window_start + i) % WINDOW];
+}
+
+/* Publish everything again from the head */
+static void rewind(void)
+{
+	for (size_t i = 0; i < q.window_count; i++) {
+		q.stats.retransmitted += window_at(i)->count;
+	}
+
+	q.window_count = 0;
+	q.read = q.head;
+}
+
+/* Erase the oldest sector to make room, its records are lost if not acknowledged */
+static int drop_oldest(void)
+{
+	int err;
+
+	err = fcb_rotate(&q.fcb);
+	if (err) {
+		LOG_ERR("fcb_rotate, error: %d", err);
+		return err;
+	}
+
+	LOG_WRN("Telemetry queue full, oldest sector dropped");
+	q.stats.dropped++;
+
+	/* The head was in the erased sector, start again from the oldest one */
+	memset(&q.head, 0, sizeof(q.head));
+	rewind();
+
+	return 0;
+}
+
+static int staging_flush(void)
+{
+	struct fcb_entry loc;
+	size_t len;
+	int err;
+
+	if (q.staged == 0) {
+		return 0;
+	}
+
+	/* Zero padding ends the records of an entry */
+	len = ROUND_UP(q.staged, q.fcb.f_align);
+	memset(&q.staging[q.staged], 0, len - q.staged);
+
+	err = fcb_append(&q.fcb, len, &loc);
+	if (err == -ENOSPC) {
+		err = drop_oldest();
+		if (!err) {
+			err = fcb_append(&q.fcb, len, &loc);
+		}
+	}
+	if (err) {
+		LOG_ERR("fcb_append, error: %d", err);
+		return err;
+	}
+
+	err = flash_area_write(q.fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), q.staging, len);
+	if (err) {
+		LOG_ERR("flash_area_write, error: %d", err);
+		return err;
+	}
+
+	err = fcb_append_finish(&q.fcb, &loc);
+	if (err) {
+		LOG_ERR("fcb_append_finish, error: %d", err);
+		return err;
+	}
+
+	q.staged = 0;
+	q.stats.entries++;
+	(void)k_work_cancel_delayable(&flush_work);
+
+	return 0;
+}
+
+/* Read the record at the cursor and move the cursor past it.
+ * Returns -ENOSPC if the record is larger than size, the record is not consumed.
+ */
+static int record_read(struct cursor *c, uint8_t *buf, size_t size, size_t *len)
+{
+	uint16_t hdr;
+	int err;
+
+	while (true) {
+		struct fcb_entry next = c->entry;
+
+		if (c->entry.fe_sector != NULL && c->off + RECORD_HDR_SIZE <= c->entry.fe_data_len) {
+			off_t data_off = FCB_ENTRY_FA_DATA_OFF(c->entry) + c->off;
+
+			err = flash_area_read(q.fcb.fap, data_off, &hdr, sizeof(hdr));
+			if (err) {
+				return err;
+			}
+
+			if (hdr == 0 || hdr > c->entry.fe_data_len - c->off - RECORD_HDR_SIZE) {
+				/* Padding */
+				c->off = c->entry.fe_data_len;
+				continue;
+			}
+
+			if (hdr > size) {
+				return -ENOSPC;
+			}
+
+			err = flash_area_read(q.fcb.fap, data_off + RECORD_HDR_SIZE, buf, hdr);
+			if (err) {
+				return err;
+			}
+
+			*len = hdr;
+			c->off += RECORD_HDR_SIZE + hdr;
+
+			return 0;
+		}
+
+		if (fcb_getnext(&q.fcb, &next)) {
+			return -ENOENT;
+		}
+
+		c->entry = next;
+		c->off = 0;
+	}
+}
+
+/* Move the head past the acknowledged records and erase the sectors it left */
+static void head_advance(void)
+{
+	while (q.window_count > 0 && window_at(0)->acked) {
+		q.window_start = (q.window_start + 1) % WINDOW;
+		q.window_count--;
+	}
+
+	q.head = (q.window_count > 0) ? window_at(0)->pos : q.read;
+
+	for (int i = 0; i < q.fcb.f_sector_cnt; i++) {
+		if (q.head.entry.fe_sector == NULL || q.head.entry.fe_sector == q.fcb.f_oldest) {
+			break;
+		}
+		if (fcb_rotate(&q.fcb)) {
+			break;
+		}
+		q.stats.rotations++;
+	}
+}
+
+/* Read up to max_count records from the cursor into message_buf.
+ * Returns the number of records read, full is set when the next one does not fit.
+ */
+static int message_read(struct cursor *c, size_t max_count, size_t *len, bool *full)
+{
+	size_t used = BATCHER ? 1 : 0;
+	size_t count = 0;
+
+	*full = false;
+
+	while (count < max_count) {
+		size_t sep = (count > 0) ? 1 : 0;
+		struct cursor next = *c;
+		size_t rec_len;
+		int err;
+
+		err = record_read(&next, &message_buf[used + sep],
+				  MESSAGE_SIZE - MESSAGE_OVERHEAD - (used - BATCHER) - sep,
+				  &rec_len);
+		if (err == -ENOSPC) {
+			*full = true;
+			break;
+		} else if (err == -ENOENT) {
+			break;
+		} else if (err) {
+			return err;
+		}
+
+		if (sep) {
+			message_buf[used] = ',';
+		}
+		used += sep + rec_len;
+		count++;
+		*c = next;
+
+		if (!BATCHER) {
+			*full = true;
+			break;
+		}
+	}
+
+	if (count == 0) {
+		return -ENOENT;
+	}
+
+	if (BATCHER) {
+		message_buf[0] = '[';
+		message_buf[used++] = ']';
+	}
+
+	*len = used;
+
+	return count;
+}
+
+static int message_publish(struct inflight *slot, size_t len)
+{
+	int err;
+
+	slot->message_id = q.next_message_id;
+	q.next_message_id = (q.next_message_id == UINT16_MAX) ? MSG_ID_FIRST :
+								 q.next_message_id + 1;
+
+	err = q.publish(message_buf, len, slot->message_id);
+	if (err) {
+		LOG_WRN("Telemetry publish failed, error: %d", err);
+		return err;
+	}
+
+	slot->sent_at = k_uptime_get();
+	q.stats.messages++;
+	q.stats.published += slot->count;
+
+	return 0;
+}
+
+/* Publish again the messages whose PUBACK did not come in time */
+static int timeouts_publish(void)
+{
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < q.window_count; i++) {
+		struct inflight *slot = window_at(i);
+		struct cursor c = slot->pos;
+		size_t len;
+		bool full;
+		int ret;
+
+		if (slot->acked || now - slot->sent_at < ACK_TIMEOUT_MS) {
+			continue;
+		}
+
+		ret = message_read(&c, slot->count, &len, &full);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = message_publish(slot, len);
+		if (ret) {
+			return ret;
+		}
+		q.stats.timeouts++;
+	}
+
+	return 0;
+}
+
+/* Write the staged records to flash for the next message, if it is due */
+static bool staging_due(size_t len)
+{
+	if (q.staged == 0) {
+		return false;
+	}
+
+	return !BATCHER || len + q.staged >= MESSAGE_SIZE - MESSAGE_OVERHEAD ||
+	       (q.batch_deadline && k_uptime_get() >= q.batch_deadline);
+}
+
+static bool batch_due(void)
+{
+	if (!q.batch_deadline) {
+		q.batch_deadline = k_uptime_get() + LATENCY_MS;
+	}
+
+	return k_uptime_get() >= q.batch_deadline;
+}
+
+/* Wake up for the next PUBACK timeout or partial message */
+static void drain_schedule(int64_t next)
+{
+	if (q.batch_deadline && (!next || q.batch_deadline < next)) {
+		next = q.batch_deadline;
+	}
+
+	for (size_t i = 0; i < q.window_count; i++) {
+		struct inflight *slot = window_at(i);
+
+		if (!slot->acked && (!next || slot->sent_at + ACK_TIMEOUT_MS < next)) {
+			next = slot->sent_at + ACK_TIMEOUT_MS;
+		}
+	}
+
+	if (next) {
+		(void)k_work_reschedule(&drain_work, K_MSEC(MAX(next - k_uptime_get(), 0)));
+	}
+}
+
+static void drain_work_fn(struct k_work *work)
+{
+	int64_t retry_at = 0;
+	int ret;
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+
+	if (!q.online) {
+		goto out;
+	}
+
+	if (timeouts_publish()) {
+		retry_at = k_uptime_get() + PUBLISH_RETRY_MS;
+		goto out;
+	}
+
+	while (q.window_count < WINDOW) {
+		struct inflight *slot = window_at(q.window_count);
+		struct cursor start = q.read;
+		size_t len = 0;
+		bool full;
+
+		ret = message_read(&q.read, SIZE_MAX, &len, &full);
+		if (ret < 0 && ret != -ENOENT) {
+			q.read = start;
+			break;
+		}
+
+		if (!full) {
+			if (staging_due(ret > 0 ? len : 0)) {
+				/* The next message needs the records held in RAM */
+				q.read = start;
+				if (staging_flush()) {
+					break;
+				}
+				continue;
+			}
+
+			if (ret == -ENOENT) {
+				if (q.staged > 0) {
+					(void)batch_due();
+				}
+				break;
+			}
+
+			if (!batch_due()) {
+				q.read = start;
+				break;
+			}
+		}
+
+		slot->pos = start;
+		slot->count = ret;
+		slot->acked = false;
+
+		if (message_publish(slot, len)) {
+			q.read = start;
+			retry_at = k_uptime_get() + PUBLISH_RETRY_MS;
+			break;
+		}
+
+		q.window_count++;
+		q.batch_deadline = 0;
+	}
+
+out:
+	if (q.online) {
+		drain_schedule(retry_at);
+	}
+
+	k_mutex_unlock(&queue_lock);
+}
+
+static void flush_work_fn(struct k_work *work)
+{
+	k_mutex_lock(&queue_lock, K_FOREVER);
+	(void)staging_flush();
+	k_mutex_unlock(&queue_lock);
+}
+
+int telemetry_queue_init(telemetry_queue_publish_t publish)
+{
+	uint32_t sector_cnt = ARRAY_SIZE(q.sectors);
+	const struct flash_area *fa;
+	int err;
+
+	err = flash_area_get_sectors(TELEMETRY_PARTITION_ID, &sector_cnt, q.sectors);
+	if (err) {
+		LOG_ERR("flash_area_get_sectors, error: %d", err);
+		return err;
+	}
+
+	q.publish = publish;
+	q.next_message_id = MSG_ID_FIRST;
+	q.fcb.f_magic = TELEMETRY_FCB_MAGIC;
+	q.fcb.f_sector_cnt = sector_cnt;
+	q.fcb.f_sectors = q.sectors;
+
+	err = fcb_init(TELEMETRY_PARTITION_ID, &q.fcb);
+	if (err) {
+		/* The partition is the queue's own, start it over empty */
+		LOG_WRN("fcb_init, error: %d, erasing the partition", err);
+
+		err = flash_area_open(TELEMETRY_PARTITION_ID, &fa);
+		if (err) {
+			return err;
+		}
+		err = flash_area_erase(fa, 0, fa->fa_size);
+		flash_area_close(fa);
+		if (err) {
+			return err;
+		}
+
+		err = fcb_init(TELEMETRY_PARTITION_ID, &q.fcb);
+		if (err) {
+			LOG_ERR("fcb_init, error: %d", err);
+			return err;
+		}
+	}
+
+	if (q.fcb.f_align > WRITE_BLOCK_MAX) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+int telemetry_queue_append(const void *data, size_t len)
+{
+	uint16_t hdr = len;
+	int err = 0;
+
+	if (len == 0 || len + RECORD_HDR_SIZE > BATCH_SIZE ||
+	    len + MESSAGE_OVERHEAD > MESSAGE_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+
+	if (q.staged + RECORD_HDR_SIZE + len > BATCH_SIZE) {
+		err = staging_flush();
+		if (err) {
+			goto out;
+		}
+	}
+
+	if (q.staged == 0) {
+		(void)k_work_schedule(&flush_work,
+				      K_MSEC(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE_FLUSH_MS));
+	}
+
+	memcpy(&q.staging[q.staged], &hdr, sizeof(hdr));
+	memcpy(&q.staging[q.staged + RECORD_HDR_SIZE], data, len);
+	q.staged += RECORD_HDR_SIZE + len;
+	q.stats.appended++;
+
+	if (q.online) {
+		(void)k_work_reschedule(&drain_work, K_NO_WAIT);
+	}
+
+out:
+	k_mutex_unlock(&queue_lock);
+
+	return err;
+}
+
+int telemetry_queue_flush(void)
+{
+	int err;
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+	err = staging_flush();
+	k_mutex_unlock(&queue_lock);
+
+	return err;
+}
+
+void telemetry_queue_set_online(bool online)
+{
+	k_mutex_lock(&queue_lock, K_FOREVER);
+
+	if (online && !q.online) {
+		rewind();
+		(void)k_work_reschedule(&drain_work, K_NO_WAIT);
+	}
+	q.online = online;
+
+	k_mutex_unlock(&queue_lock);
+}
+
+int telemetry_queue_ack(uint16_t message_id)
+{
+	int err = -ENOENT;
+
+	k_mutex_lock(&queue_lock, K_FOREVER);
+
+	for (size_t i = 0; i < q.window_count; i++) {
+		struct inflight *slot = window_at(i);
+
+		if (slot->message_id == message_id && !slot->acked) {
+			slot->acked = true;
+			q.stats.acked += slot->count;
+			err = 0;
+			break;
+		}
+	}
+
+	if (!err) {
+		head_advance();
+		(void)k_work_reschedule(&drain_work, K_NO_WAIT);
+	}
+
+	k_mutex_unlock(&queue_lock);
+
+	return err;
+}
+
+void telemetry_queue_stats_get(struct telemetry_queue_stats *stats)
+{
+	k_mutex_lock(&queue_lock, K_FOREVER);
+	*stats = q.stats;
+	k_mutex_unlock(&queue_lock);
+}
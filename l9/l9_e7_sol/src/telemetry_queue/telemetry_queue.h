@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TELEMETRY_QUEUE_H_
+#define TELEMETRY_QUEUE_H_
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+/* @brief Publish a message with QoS 1.
+ *
+ * @param[in] data       A record, or a JSON array of records with
+ *			 CONFIG_AWS_IOT_SAMPLE_TELEMETRY_BATCHER.
+ * @param[in] len        Length of the message.
+ * @param[in] message_id MQTT message ID, reported back with telemetry_queue_ack().
+ *
+ * @return 0 on success, otherwise a negative value. The message is published again later.
+ */
+typedef int (*telemetry_queue_publish_t)(const uint8_t *data, size_t len, uint16_t message_id);
+
+/* Counters since telemetry_queue_init(). */
+struct telemetry_queue_stats {
+	/* Records appended. */
+	uint32_t appended;
+	/* Flash entries written, each holding one or more records. */
+	uint32_t entries;
+	/* MQTT messages published, retransmissions included. */
+	uint32_t messages;
+	/* Records published, retransmissions included. */
+	uint32_t published;
+	/* Records acknowledged. */
+	uint32_t acked;
+	/* Records published again after a reconnection. */
+	uint32_t retransmitted;
+	/* Messages published again after waiting too long for their PUBACK. */
+	uint32_t timeouts;
+	/* Sectors erased once all their records were acknowledged. */
+	uint32_t rotations;
+	/* Sectors erased with records not acknowledged, because the partition was full. */
+	uint32_t dropped;
+};
+
+#if defined(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE)
+
+/* @brief Mount the queue, keeping the records stored before a reset.
+ *
+ * The queue starts offline.
+ *
+ * @param[in] publish Function publishing a record.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int telemetry_queue_init(telemetry_queue_publish_t publish);
+
+/* @brief Append a record to the queue.
+ *
+ * The record is copied. When the partition is full, the oldest sector is
+ * erased whether its records were sent or not.
+ *
+ * @return 0 on success, -EMSGSIZE if the record does not fit in a flash entry or
+ *	   in a message, otherwise a negative value.
+ */
+int telemetry_queue_append(const void *data, size_t len);
+
+/* @brief Write the records held in RAM to flash. */
+int telemetry_queue_flush(void);
+
+/* @brief Start or stop draining the queue.
+ *
+ * Records published and not acknowledged when going offline are published
+ * again when going online.
+ */
+void telemetry_queue_set_online(bool online);
+
+/* @brief Acknowledge a message, on the PUBACK of its message ID.
+ *
+ * @return 0 on success, -ENOENT if no message was published with this message ID.
+ */
+int telemetry_queue_ack(uint16_t message_id);
+
+/* @brief Get the counters of the queue. */
+void telemetry_queue_stats_get(struct telemetry_queue_stats *stats);
+
+#else
+
+static inline void telemetry_queue_set_online(bool online)
+{
+}
+
+static inline int telemetry_queue_ack(uint16_t message_id)
+{
+	return -ENOENT;
+}
+
+#endif /* CONFIG_AWS_IOT_SAMPLE_TELEMETRY_QUEUE */
+
+#endif /* TELEMETRY_QUEUE_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* MQTT broker stand-in: acknowledges QoS 1 publishes after a fixed latency,
+ * loses CONFIG_TELEMETRY_BENCH_BROKER_LOSS_PERCENT of them, and drops the
+ * ones in flight when the client disconnects.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "broker.h"
+
+#define BROKER_QUEUE_LEN    16
+#define BROKER_STACK_SIZE   2048
+#define BROKER_PRIORITY	    K_PRIO_PREEMPT(1)
+
+/* PUBLISH fixed header, topic and message ID; PUBACK */
+#define PUBLISH_OVERHEAD    (2 + 2 + sizeof(CONFIG_AWS_IOT_SAMPLE_TELEMETRY_TOPIC) - 1 + 2)
+#define PUBACK_SIZE	    4
+
+struct broker_msg {
+	uint32_t generation;
+	int64_t due;
+	uint16_t message_id;
+	uint16_t len;
+	uint8_t data[BROKER_MESSAGE_SIZE_MAX];
+};
+
+K_MSGQ_DEFINE(broker_queue, sizeof(struct broker_msg), BROKER_QUEUE_LEN, 4);
+
+static broker_deliver_t deliver_cb;
+static broker_puback_t puback_cb;
+
+/* Incremented on every disconnection, messages of an older connection are lost */
+static atomic_t generation;
+static atomic_t connected;
+static struct broker_stats stats;
+static uint32_t loss_seed = 1;
+static K_SPINLOCK_DEFINE(stats_lock);
+
+static void broker_thread_fn(void *p1, void *p2, void *p3)
+{
+	static struct broker_msg msg;
+
+	while (true) {
+		k_msgq_get(&broker_queue, &msg, K_FOREVER);
+
+		k_sleep(K_MSEC(MAX(msg.due - k_uptime_get(), 0)));
+
+		/* Same sequence of losses on every run */
+		loss_seed = loss_seed * 1103515245U + 12345U;
+
+		if (!atomic_get(&connected) || msg.generation != atomic_get(&generation)) {
+			K_SPINLOCK(&stats_lock) {
+				stats.lost++;
+			}
+			continue;
+		}
+
+		if ((loss_seed >> 16) % 100 < CONFIG_TELEMETRY_BENCH_BROKER_LOSS_PERCENT) {
+			K_SPINLOCK(&stats_lock) {
+				stats.lost++;
+				stats.lost_random++;
+			}
+			continue;
+		}
+
+		deliver_cb(msg.data, msg.len);
+
+		K_SPINLOCK(&stats_lock) {
+			stats.pubacks++;
+			stats.wire_bytes += PUBACK_SIZE;
+		}
+		puback_cb(msg.message_id);
+	}
+}
+
+K_THREAD_DEFINE(broker_thread, BROKER_STACK_SIZE, broker_thread_fn, NULL, NULL, NULL,
+		BROKER_PRIORITY, 0, 0);
+
+void broker_init(broker_deliver_t deliver, broker_puback_t puback)
+{
+	deliver_cb = deliver;
+	puback_cb = puback;
+}
+
+void broker_connect(bool connect)
+{
+	if (!connect) {
+		atomic_inc(&generation);
+	}
+	atomic_set(&connected, connect);
+}
+
+int broker_publish(const uint8_t *data, size_t len, uint16_t message_id)
+{
+	struct broker_msg msg;
+
+	if (!atomic_get(&connected)) {
+		return -ENOTCONN;
+	}
+	if (len > sizeof(msg.data)) {
+		return -EMSGSIZE;
+	}
+
+	msg.generation = atomic_get(&generation);
+	msg.due = k_uptime_get() + CONFIG_TELEMETRY_BENCH_BROKER_LATENCY_MS;
+	msg.message_id = message_id;
+	msg.len = len;
+	memcpy(msg.data, data, len);
+
+	if (k_msgq_put(&broker_queue, &msg, K_NO_WAIT)) {
+		return -ENOMEM;
+	}
+
+	K_SPINLOCK(&stats_lock) {
+		stats.messages++;
+		stats.bytes += len;
+		stats.wire_bytes += PUBLISH_OVERHEAD + len;
+	}
+
+	return 0;
+}
+
+void broker_stats_get(struct broker_stats *out)
+{
+	K_SPINLOCK(&stats_lock) {
+		*out = stats;
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BROKER_H_
+#define BROKER_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+/* Largest message the broker stand-in accepts. */
+#define BROKER_MESSAGE_SIZE_MAX 256
+
+/* Traffic seen by the broker stand-in, as a proxy for the radio on time. */
+struct broker_stats {
+	/* PUBLISH packets received. */
+	uint32_t messages;
+	/* Payload bytes received. */
+	uint32_t bytes;
+	/* PUBACK packets sent, each one a round trip. */
+	uint32_t pubacks;
+	/* PUBLISH packets lost, on a disconnection or at random. */
+	uint32_t lost;
+	/* Part of lost, at random. */
+	uint32_t lost_random;
+	/* MQTT bytes of the PUBLISH and PUBACK packets, without TLS and TCP. */
+	uint32_t wire_bytes;
+};
+
+/* @brief Called for every message the broker accepts, before its PUBACK. */
+typedef void (*broker_deliver_t)(const uint8_t *data, size_t len);
+
+/* @brief Called with the message ID of every PUBACK. */
+typedef void (*broker_puback_t)(uint16_t message_id);
+
+/* @brief Start the broker stand-in, disconnected. */
+void broker_init(broker_deliver_t deliver, broker_puback_t puback);
+
+/* @brief Connect or disconnect the client.
+ *
+ * Messages not acknowledged yet are lost on a disconnection, as with a clean session.
+ */
+void broker_connect(bool connected);
+
+/* @brief Publish a QoS 1 message, acknowledged after CONFIG_TELEMETRY_BENCH_BROKER_LATENCY_MS.
+ *
+ * The message is counted as received even if it is lost later.
+ *
+ * @return 0 on success, -ENOTCONN when disconnected, -ENOMEM if the broker is congested.
+ */
+int broker_publish(const uint8_t *data, size_t len, uint16_t message_id);
+
+/* @brief Get the traffic counters. */
+void broker_stats_get(struct broker_stats *stats);
+
+#endif /* BROKER_H_ */
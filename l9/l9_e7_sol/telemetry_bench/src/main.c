@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Store and forward telemetry queue of l9_e7_sol against a broker stand-in.
+ *
+ * Records are produced while connected, then while disconnected with
+ * publishes in flight, then the connection comes back. Every record must
+ * reach the broker, in any order: a message published again after a loss
+ * arrives after the ones that followed it. Duplicates are allowed, the
+ * records in flight at the disconnection or lost are published again. With
+ * CONFIG_TELEMETRY_BENCH_BROKER_LOSS_PERCENT, the broker must have lost some.
+ *
+ * The messages, bytes and round trips seen by the broker while draining the
+ * backlog stand in for the radio on time. Compare the runs with and without
+ * CONFIG_AWS_IOT_SAMPLE_TELEMETRY_BATCHER.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/bitarray.h>
+
+#include "broker.h"
+#include "telemetry_queue.h"
+
+#define ONLINE_RECORDS	100
+#define OFFLINE_RECORDS 200
+#define RECORDS		(ONLINE_RECORDS + OFFLINE_RECORDS)
+#define RECORD_SIZE_MAX	48
+#define DRAIN_TIMEOUT_MS 30000
+
+SYS_BITARRAY_DEFINE_STATIC(delivered, RECORDS);
+
+static atomic_t delivered_count;
+static atomic_t duplicates;
+/* Records that were never produced */
+static atomic_t invalid;
+
+static void record_deliver(uint32_t seq)
+{
+	int prev;
+
+	if (seq >= RECORDS) {
+		atomic_inc(&invalid);
+		return;
+	}
+
+	sys_bitarray_test_and_set_bit(&delivered, seq, &prev);
+	if (prev) {
+		atomic_inc(&duplicates);
+		return;
+	}
+
+	atomic_inc(&delivered_count);
+}
+
+/* A {"seq":N,...} record, or a JSON array of them */
+static void on_deliver(const uint8_t *data, size_t len)
+{
+	static char message[BROKER_MESSAGE_SIZE_MAX + 1];
+	const char *key = "\"seq\":";
+	char *p = message;
+
+	memcpy(message, data, len);
+	message[len] = '\0';
+
+	while ((p = strstr(p, key)) != NULL) {
+		p += strlen(key);
+		record_deliver(strtoul(p, &p, 10));
+	}
+}
+
+static void on_puback(uint16_t message_id)
+{
+	(void)telemetry_queue_ack(message_id);
+}
+
+static void produce(uint32_t first, uint32_t count)
+{
+	char record[RECORD_SIZE_MAX];
+
+	for (uint32_t seq = first; seq < first + count; seq++) {
+		int len = snprintk(record, sizeof(record), "{\"seq\":%u,\"uptime\":%u}", seq,
+				   (uint32_t)k_uptime_get());
+
+		if (telemetry_queue_append(record, len)) {
+			printk("Append of record %u failed\n", seq);
+		}
+		k_sleep(K_MSEC(1));
+	}
+}
+
+static void set_connected(bool connected)
+{
+	broker_connect(connected);
+	telemetry_queue_set_online(connected);
+}
+
+int main(void)
+{
+	struct telemetry_queue_stats queue;
+	struct broker_stats offline;
+	struct broker_stats broker;
+	int64_t start;
+	int64_t drain_ms;
+	int err;
+
+	broker_init(on_deliver, on_puback);
+
+	err = telemetry_queue_init(broker_publish);
+	if (err) {
+		printk("telemetry_queue_init, error: %d\n", err);
+		return 0;
+	}
+
+	set_connected(true);
+	produce(0, ONLINE_RECORDS);
+
+	/* Publishes of the last records are still in flight */
+	set_connected(false);
+	produce(ONLINE_RECORDS, OFFLINE_RECORDS);
+	printk("Offline: %ld of %d records delivered\n", atomic_get(&delivered_count), RECORDS);
+	broker_stats_get(&offline);
+
+	start = k_uptime_get();
+	set_connected(true);
+	while (atomic_get(&delivered_count) < RECORDS &&
+	       k_uptime_get() - start < DRAIN_TIMEOUT_MS) {
+		k_sleep(K_MSEC(10));
+	}
+	drain_ms = k_uptime_get() - start;
+
+	/* Let the last PUBACKs in */
+	k_sleep(K_MSEC(2 * CONFIG_TELEMETRY_BENCH_BROKER_LATENCY_MS));
+
+	telemetry_queue_stats_get(&queue);
+	broker_stats_get(&broker);
+
+	/* Traffic of the drain only */
+	offline.messages = broker.messages - offline.messages;
+	offline.bytes = broker.bytes - offline.bytes;
+	offline.wire_bytes = broker.wire_bytes - offline.wire_bytes;
+	offline.pubacks = broker.pubacks - offline.pubacks;
+
+	printk("Drained the backlog in %lld ms: %lld records/s, %lld messages/s\n", drain_ms,
+	       drain_ms ? (OFFLINE_RECORDS * 1000LL) / drain_ms : 0,
+	       drain_ms ? (offline.messages * 1000LL) / drain_ms : 0);
+	printk("drain: messages %u payload bytes %u wire bytes %u round trips %u\n",
+	       offline.messages, offline.bytes, offline.wire_bytes, offline.pubacks);
+	printk("queue: appended %u entries %u messages %u published %u acked %u "
+	       "retransmitted %u timeouts %u rotations %u dropped %u\n", queue.appended,
+	       queue.entries, queue.messages, queue.published, queue.acked, queue.retransmitted,
+	       queue.timeouts, queue.rotations, queue.dropped);
+	printk("broker: messages %u bytes %u wire bytes %u pubacks %u lost %u (%u at random)\n",
+	       broker.messages, broker.bytes, broker.wire_bytes, broker.pubacks, broker.lost,
+	       broker.lost_random);
+	printk("delivered %ld/%d duplicates %ld invalid %ld\n", atomic_get(&delivered_count),
+	       RECORDS, atomic_get(&duplicates), atomic_get(&invalid));
+
+	/* The lossy run must have recovered from actual losses */
+	if (atomic_get(&delivered_count) == RECORDS && atomic_get(&invalid) == 0 &&
+	    queue.dropped == 0 &&
+	    (CONFIG_TELEMETRY_BENCH_BROKER_LOSS_PERCENT == 0 || broker.lost_random > 0)) {
+		printk("Telemetry queue test passed\n");
+	} else {
+		printk("Telemetry queue test FAILED\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Fetch the core dump stored in flash by l2_e2_sol.
+
+The sample must be built with overlay-coredump-flash.conf and
+overlay-coredump-mcumgr.conf. The dump is read over mcumgr, decompressed
+and written in the binary format expected by the Zephyr core dump GDB
+server:
+
+    coredump_fetch.py /dev/ttyACM0 -o dump.bin
+    $ZEPHYR_BASE/scripts/coredump/coredump_gdbserver.py build/l2_e2_sol/zephyr/zephyr.elf dump.bin
+"""
+
+import argparse
+import sys
+
+from smp_serial import OP_READ, OP_WRITE, SmpSerial
+
+GROUP_COREDUMP = 64
+ID_INFO = 0
+ID_DATA = 1
+
+RLE_RUN_MIN = 3
+
+
+def rle_decode(data):
+    """Decode the run-length encoding used by src/coredump_flash.c."""
+    out = bytearray()
+    i = 0
+
+    while i < len(data):
+        control = data[i]
+        i += 1
+        if control < 0x80:
+            out += data[i:i + control + 1]
+            i += control + 1
+        else:
+            out += bytes([data[i]]) * (control - 0x80 + RLE_RUN_MIN)
+            i += 1
+
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port of the device")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    parser.add_argument("-o", "--output", default="coredump.bin",
+                        help="output file (default: %(default)s)")
+    parser.add_argument("--erase", action="store_true",
+                        help="erase the dump on the device after fetching it")
+    args = parser.parse_args()
+
+    with SmpSerial(args.port, args.baudrate) as smp:
+        info = smp.request(OP_READ, GROUP_COREDUMP, ID_INFO)
+        if not info.get("present"):
+            sys.exit("No core dump stored on the device")
+
+        print(f"Core dump: {info['raw']} bytes, {info['stored']} bytes stored, "
+              f"written in {info['fault_us']} us")
+
+        stored = bytearray()
+        while len(stored) < info["stored"]:
+            rsp = smp.request(OP_READ, GROUP_COREDUMP, ID_DATA, {"off": len(stored)})
+            if not rsp["data"]:
+                break
+            stored += rsp["data"]
+            print(f"\r{len(stored)}/{info['stored']}", end="", flush=True)
+        print()
+
+        if args.erase:
+            smp.request(OP_WRITE, GROUP_COREDUMP, ID_DATA)
+
+    dump = rle_decode(stored) if info["rle"] else bytes(stored)
+    if len(dump) != info["raw"]:
+        sys.exit(f"Decoded {len(dump)} bytes, expected {info['raw']}")
+
+    with open(args.output, "wb") as f:
+        f.write(dump)
+    print(f"Wrote {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Make a delta patch between two images for common/delta/delta.c.
+
+The patch rebuilds the new image from the one running on the device, the
+MCUboot primary slot, with copy commands for the parts found in it and
+insert commands for the rest. Both images are the signed ones, so the
+rebuilt image is bit for bit the new signed image:
+
+    delta_diff.py build_v1/zephyr/zephyr.signed.bin build_v2/zephyr/zephyr.signed.bin \\
+        -o update.delta
+
+The patch is applied again in Python to check it before it is written.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b"DLT1"
+OP_END = 0x00
+OP_COPY = 0x01
+OP_INSERT = 0x02
+
+# Bytes hashed to look a match up, and the shortest match worth a copy command
+BLOCK = 16
+# Positions of the old image indexed, matches are extended backwards to their start
+INDEX_STEP = 4
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return value << 1 if value >= 0 else ((-value) << 1) - 1
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def match_len(old, old_pos, new, new_pos):
+    n = 0
+    limit = min(len(old) - old_pos, len(new) - new_pos)
+    while n < limit and old[old_pos + n] == new[new_pos + n]:
+        n += 1
+    return n
+
+
+def diff(old, new):
+    """Return the list of ("copy", offset, length) and ("insert", bytes) commands."""
+    index = {}
+    for i in range(0, len(old) - BLOCK + 1, INDEX_STEP):
+        index.setdefault(old[i:i + BLOCK], i)
+
+    commands = []
+    literal_start = 0
+    copy_end = 0
+    pos = 0
+
+    while pos <= len(new) - BLOCK:
+        # The next copy usually continues the previous one
+        candidates = [copy_end, index.get(new[pos:pos + BLOCK])]
+        best_len = 0
+        best_old = 0
+        for old_pos in candidates:
+            if old_pos is None or old_pos >= len(old):
+                continue
+            n = match_len(old, old_pos, new, pos)
+            if n > best_len:
+                best_len, best_old = n, old_pos
+
+        if best_len < BLOCK:
+            pos += 1
+            continue
+
+        # Extend the match backwards over the pending literals
+        while pos > literal_start and best_old > 0 and old[best_old - 1] == new[pos - 1]:
+            pos -= 1
+            best_old -= 1
+            best_len += 1
+
+        if pos > literal_start:
+            commands.append(("insert", new[literal_start:pos]))
+        commands.append(("copy", best_old, best_len))
+        copy_end = best_old + best_len
+        pos += best_len
+        literal_start = pos
+
+    if literal_start < len(new):
+        commands.append(("insert", new[literal_start:]))
+
+    return commands
+
+
+def encode(old, new, commands):
+    out = bytearray(MAGIC)
+    out += struct.pack("<I", len(old)) + hashlib.sha256(old).digest()
+    out += struct.pack("<I", len(new)) + hashlib.sha256(new).digest()
+
+    copy_end = 0
+    for command in commands:
+        if command[0] == "copy":
+            _, offset, length = command
+            out.append(OP_COPY)
+            out += varint(zigzag(offset - copy_end)) + varint(length)
+            copy_end = offset + length
+        else:
+            data = command[1]
+            out.append(OP_INSERT)
+            out += varint(len(data)) + data
+    out.append(OP_END)
+
+    return bytes(out)
+
+
+def apply(old, patch):
+    """Apply a patch the way the device does, returns the new image."""
+    if patch[:4] != MAGIC:
+        raise ValueError("not a patch")
+
+    old_size, = struct.unpack_from("<I", patch, 4)
+    new_size, = struct.unpack_from("<I", patch, 40)
+    if old_size != len(old) or hashlib.sha256(old).digest() != patch[8:40]:
+        raise ValueError("patch made against another image")
+
+    new = bytearray()
+    copy_end = 0
+    pos = 76
+    while True:
+        op = patch[pos]
+        pos += 1
+        if op == OP_END:
+            break
+        if op == OP_COPY:
+            value, pos = read_varint(patch, pos)
+            length, pos = read_varint(patch, pos)
+            offset = copy_end + ((value >> 1) ^ -(value & 1))
+            new += old[offset:offset + length]
+            copy_end = offset + length
+        elif op == OP_INSERT:
+            length, pos = read_varint(patch, pos)
+            new += patch[pos:pos + length]
+            pos += length
+        else:
+            raise ValueError(f"unknown opcode {op:#x}")
+
+    if len(new) != new_size or hashlib.sha256(new).digest() != patch[44:76]:
+        raise ValueError("hash of the new image differs")
+
+    return bytes(new)
+
+
+def make_patch(old, new):
+    """Return a checked patch rebuilding new from old."""
+    patch = encode(old, new, diff(old, new))
+    if apply(old, patch) != new:
+        raise ValueError("patch does not rebuild the new image")
+    return patch
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("old", help="image running on the device")
+    parser.add_argument("new", help="image to update to")
+    parser.add_argument("-o", "--output", required=True, help="patch file")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+    with open(args.new, "rb") as f:
+        new = f.read()
+
+    try:
+        patch = make_patch(old, new)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    with open(args.output, "wb") as f:
+        f.write(patch)
+
+    print(f"{args.output}: {len(patch)} bytes, {100 * len(patch) / len(new):.1f}% "
+          f"of the {len(new)} byte image")
+
+
+if __name__ == "__main__":
+    main()
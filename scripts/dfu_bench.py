@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Time an image upload over mcumgr, uncompressed and compressed or as a patch.
+
+For l9_e2_sol over UART and l9_e5_sol over Bluetooth LE, built with
+overlay-lz4.conf:
+
+    dfu_bench.py /dev/ttyACM0 build/l9_e2_sol/zephyr/zephyr.signed.bin
+    dfu_bench.py --ble D4:3A:1B:2C:5E:6F build/l9_e5_sol/zephyr/zephyr.signed.bin
+
+The signed image is uploaded with the image management group, then
+compressed by lz4_pack.py and uploaded with the group of
+common/lz4/lz4_img_mgmt.c, which decompresses it into the secondary slot.
+Each upload is timed from the first request to the last response, sent
+once the last byte is in flash, so the times cover transfer and write.
+
+With --old and the signed image running on the device, built with
+common/delta/overlay-delta-dfu.conf instead, the second upload is a patch
+made by delta_diff.py, sent with the group of common/delta/delta_img_mgmt.c,
+which rebuilds the image into the secondary slot:
+
+    dfu_bench.py --old build_v1/zephyr/zephyr.signed.bin /dev/ttyACM0 \
+        build_v2/zephyr/zephyr.signed.bin
+
+With --test the image is marked for test after the second upload: MCUboot
+validates the rebuilt image and swaps it in at the next reset.
+"""
+
+import argparse
+import hashlib
+import sys
+import time
+
+from delta_diff import make_patch
+from lz4_pack import WINDOW_DEFAULT, pack
+from smp_serial import OP_READ, OP_WRITE, SmpError, SmpSerial
+
+GROUP_IMAGE = 1
+ID_IMAGE_STATE = 0
+ID_IMAGE_UPLOAD = 1
+
+GROUP_LZ4_IMAGE = 65
+ID_LZ4_UPLOAD = 0
+
+GROUP_DELTA_IMAGE = 66
+ID_DELTA_UPLOAD = 0
+
+
+def upload(smp, group, command, data, chunk, first):
+    """Send data in chunks, first holds the extra fields of the first request."""
+    start = time.monotonic()
+    requests = 0
+    off = 0
+    rsp = {}
+
+    while off < len(data):
+        req = {"off": off, "data": data[off:off + chunk]}
+        if off == 0:
+            req.update(first)
+        rsp = smp.request(OP_WRITE, group, command, req)
+        off = rsp["off"]
+        requests += 1
+
+    return time.monotonic() - start, requests, rsp
+
+
+def image_test(smp):
+    """Mark the image in the secondary slot for test."""
+    images = smp.request(OP_READ, GROUP_IMAGE, ID_IMAGE_STATE)["images"]
+    secondary = [image for image in images if image.get("slot") == 1]
+    if not secondary:
+        raise SmpError("no image in the secondary slot")
+
+    smp.request(OP_WRITE, GROUP_IMAGE, ID_IMAGE_STATE,
+                {"hash": secondary[0]["hash"], "confirm": False})
+
+
+def rate(size, seconds):
+    return size / 1024 / seconds if seconds else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("device", help="serial port, or Bluetooth LE address with --ble")
+    parser.add_argument("image", help="signed image")
+    parser.add_argument("--ble", action="store_true", help="connect over Bluetooth LE")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    parser.add_argument("-c", "--chunk", type=int, default=128,
+                        help="data bytes per request (default: %(default)s)")
+    parser.add_argument("-w", "--window", type=int, default=WINDOW_DEFAULT,
+                        help="CONFIG_DEVACADEMY_LZ4_WINDOW_SIZE (default: %(default)s)")
+    parser.add_argument("--old", metavar="IMAGE",
+                        help="signed image running on the device, upload a patch against it")
+    parser.add_argument("--test", action="store_true",
+                        help="mark the image for test after the second upload")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    if args.old:
+        with open(args.old, "rb") as f:
+            old = f.read()
+        try:
+            packed = make_patch(old, image)
+        except ValueError as e:
+            sys.exit(str(e))
+        group, command, name = GROUP_DELTA_IMAGE, ID_DELTA_UPLOAD, "patch:"
+    else:
+        packed = pack(image, args.window)
+        group, command, name = GROUP_LZ4_IMAGE, ID_LZ4_UPLOAD, "compressed:"
+
+    if args.ble:
+        from smp_ble import SmpBle
+        smp = SmpBle(args.device)
+    else:
+        smp = SmpSerial(args.device, args.baudrate)
+
+    with smp:
+        try:
+            raw_s, raw_requests, _ = upload(
+                smp, GROUP_IMAGE, ID_IMAGE_UPLOAD, image, args.chunk,
+                {"image": 0, "len": len(image), "sha": hashlib.sha256(image).digest()})
+            lz4_s, lz4_requests, rsp = upload(
+                smp, group, command, packed, args.chunk, {"len": len(packed)})
+            if args.test:
+                image_test(smp)
+        except SmpError as e:
+            sys.exit(str(e))
+
+    print(f"uncompressed: {len(image)} bytes in {raw_requests} requests, {raw_s:.1f} s, "
+          f"{rate(len(image), raw_s):.1f} KB/s")
+    print(f"{name:13} {len(packed)} bytes in {lz4_requests} requests, {lz4_s:.1f} s, "
+          f"{rate(len(image), lz4_s):.1f} KB/s of image, {rsp.get('ms', 0)} ms on the device")
+    print(f"{100 * len(packed) / len(image):.1f}% of the bytes, "
+          f"{100 * lz4_s / raw_s:.1f}% of the time")
+
+
+if __name__ == "__main__":
+    main()
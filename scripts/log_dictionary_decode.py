@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Decode dictionary-based log output from a course sample.
+
+Samples built with common/log/overlay-log-dictionary.conf emit binary log
+records that only carry format string addresses and arguments. This script
+finds the log database of the build and hands the capture, or a live serial
+port, to the Zephyr dictionary log parser.
+
+Examples:
+    log_dictionary_decode.py -b build --serial /dev/ttyACM0
+    log_dictionary_decode.py -b build --file capture.bin
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+
+def find_database(build_dir):
+    """Return the log_dictionary.json of a sysbuild or single image build."""
+    candidates = [build_dir / "zephyr" / "log_dictionary.json"]
+    candidates += sorted(build_dir.glob("*/zephyr/log_dictionary.json"))
+
+    for candidate in candidates:
+        if candidate.is_file():
+            return candidate
+
+    sys.exit(f"No log_dictionary.json found in {build_dir}, was the sample "
+             "built with overlay-log-dictionary.conf?")
+
+
+def find_parser_dir():
+    zephyr_base = os.environ.get("ZEPHYR_BASE")
+    if not zephyr_base:
+        sys.exit("ZEPHYR_BASE is not set")
+
+    parser_dir = Path(zephyr_base) / "scripts" / "logging" / "dictionary"
+    if not parser_dir.is_dir():
+        sys.exit(f"Dictionary log parser not found in {parser_dir}")
+
+    return parser_dir
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-b", "--build-dir", type=Path, default=Path("build"),
+                        help="Build directory of the sample (default: build)")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--file", type=Path, help="Binary capture of the log output")
+    source.add_argument("--serial", help="Serial port to decode live")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    args = parser.parse_args()
+
+    database = find_database(args.build_dir)
+    parser_dir = find_parser_dir()
+
+    if args.file:
+        cmd = [sys.executable, str(parser_dir / "log_parser.py"), str(database), str(args.file)]
+    elif (parser_dir / "live_log_parser.py").is_file():
+        cmd = [sys.executable, str(parser_dir / "live_log_parser.py"), str(database),
+               "serial", args.serial, str(args.baudrate)]
+    else:
+        cmd = [sys.executable, str(parser_dir / "log_parser_uart.py"), str(database),
+               args.serial, str(args.baudrate)]
+
+    try:
+        return subprocess.call(cmd)
+    except KeyboardInterrupt:
+        return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
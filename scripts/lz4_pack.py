@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Compress an image for common/lz4/lz4_stream.c.
+
+The image is compressed as one LZ4 block, with matches limited to a window
+the device can keep in RAM. Compress the signed image, the device
+decompresses it into the MCUboot secondary slot and MCUboot validates the
+result as for an uncompressed upload:
+
+    lz4_pack.py build/l9_e2_sol/zephyr/zephyr.signed.bin -o update.lz4
+
+The window must not be larger than CONFIG_DEVACADEMY_LZ4_WINDOW_SIZE on the
+device. The data is decompressed again in Python to check it before it is
+written.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"DLZ4"
+WINDOW_DEFAULT = 4096
+
+MIN_MATCH = 4
+# Rules of the LZ4 block format: the last 5 bytes are literals and the last
+# match starts at least 12 bytes before the end
+LAST_LITERALS = 5
+MF_LIMIT = 12
+LEN_EXTENDED = 15
+# Earlier positions with the same 4 bytes tried for each match
+CHAIN_DEPTH = 16
+
+
+def _length(out, value):
+    """Extension bytes of a length that does not fit the token."""
+    value -= LEN_EXTENDED
+    while value >= 0xFF:
+        out.append(0xFF)
+        value -= 0xFF
+    out.append(value)
+
+
+def _sequence(out, literals, match_len=0, offset=0):
+    lit = min(len(literals), LEN_EXTENDED)
+    match = min(match_len - MIN_MATCH, LEN_EXTENDED) if match_len else 0
+
+    out.append(lit << 4 | match)
+    if lit == LEN_EXTENDED:
+        _length(out, len(literals))
+    out += literals
+
+    if match_len:
+        out += struct.pack("<H", offset)
+        if match == LEN_EXTENDED:
+            _length(out, match_len - MIN_MATCH)
+
+
+def compress(data, window=WINDOW_DEFAULT):
+    """Return data compressed, with matches starting less than window bytes back."""
+    out = bytearray(MAGIC + struct.pack("<II", len(data), window))
+    chains = {}
+    end = len(data) - MF_LIMIT
+    anchor = 0
+    i = 0
+
+    def insert(pos):
+        chain = chains.setdefault(data[pos:pos + MIN_MATCH], [])
+        chain.append(pos)
+        if len(chain) > CHAIN_DEPTH:
+            del chain[0]
+
+    while i < end:
+        best_len = 0
+        best_pos = 0
+
+        for pos in reversed(chains.get(data[i:i + MIN_MATCH], ())):
+            if i - pos >= window:
+                break
+            length = MIN_MATCH
+            limit = len(data) - LAST_LITERALS - i
+            while length < limit and data[pos + length] == data[i + length]:
+                length += 1
+            if length > best_len:
+                best_len, best_pos = length, pos
+
+        if best_len < MIN_MATCH:
+            insert(i)
+            i += 1
+            continue
+
+        _sequence(out, data[anchor:i], best_len, i - best_pos)
+        for pos in range(i, min(i + best_len, end)):
+            insert(pos)
+        i += best_len
+        anchor = i
+
+    # The last sequence is literals only
+    if anchor < len(data):
+        _sequence(out, data[anchor:])
+
+    return bytes(out)
+
+
+def decompress(packed):
+    """Return the image decompressed, the way the device does it."""
+    if packed[:4] != MAGIC:
+        raise ValueError("not a compressed image")
+
+    size, window = struct.unpack("<II", packed[4:12])
+    out = bytearray()
+    i = 12
+
+    def length(value):
+        nonlocal i
+        if value == LEN_EXTENDED:
+            while True:
+                byte = packed[i]
+                i += 1
+                value += byte
+                if byte != 0xFF:
+                    break
+        return value
+
+    while len(out) < size:
+        token = packed[i]
+        i += 1
+        lit = length(token >> 4)
+        out += packed[i:i + lit]
+        i += lit
+        if len(out) >= size:
+            break
+
+        offset = struct.unpack("<H", packed[i:i + 2])[0]
+        i += 2
+        if not 0 < offset < window or offset > len(out):
+            raise ValueError(f"match {offset} bytes back at {len(out)}")
+        for _ in range(length(token & 0x0F) + MIN_MATCH):
+            out.append(out[-offset])
+
+    if len(out) != size or i != len(packed):
+        raise ValueError("size mismatch")
+
+    return bytes(out)
+
+
+def pack(data, window=WINDOW_DEFAULT):
+    """Return data compressed and checked."""
+    packed = compress(data, window)
+    if decompress(packed) != data:
+        raise ValueError("compressed image does not decompress to the input")
+    return packed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("image", help="signed image")
+    parser.add_argument("-o", "--output", required=True, help="compressed image file")
+    parser.add_argument("-w", "--window", type=int, default=WINDOW_DEFAULT,
+                        help="window size of the device (default: %(default)s)")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+
+    try:
+        packed = pack(data, args.window)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    with open(args.output, "wb") as f:
+        f.write(packed)
+
+    print(f"{args.output}: {len(packed)} bytes, {100 * len(packed) / len(data):.1f}% "
+          f"of the {len(data)} byte image")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""SMP (mcumgr) client for the Bluetooth LE transport.
+
+Same requests as smp_serial.SmpClient, over the SMP GATT service. Requires
+bleak. Requests larger than the ATT MTU are split over several writes,
+the device must reassemble them (CONFIG_MCUMGR_TRANSPORT_BT_REASSEMBLY).
+"""
+
+import asyncio
+import struct
+
+from bleak import BleakClient
+
+from smp_serial import SmpClient, SmpError
+
+SMP_CHARACTERISTIC = "da2e7828-fbce-4e01-ae9e-261174997c48"
+_HDR_SIZE = 8
+_ATT_HDR_SIZE = 3
+
+
+class SmpBle(SmpClient):
+    """SMP client on the SMP characteristic of a connected device."""
+
+    def __init__(self, address, timeout=5.0):
+        super().__init__()
+        self._timeout = timeout
+        self._loop = asyncio.new_event_loop()
+        self._rx = asyncio.Queue()
+        self._client = BleakClient(address)
+
+        self._run(self._client.connect())
+        self._run(self._client.start_notify(SMP_CHARACTERISTIC, self._notify))
+        self.mtu = self._client.mtu_size - _ATT_HDR_SIZE
+
+    def close(self):
+        self._run(self._client.disconnect())
+        self._loop.close()
+
+    def _run(self, coro):
+        return self._loop.run_until_complete(coro)
+
+    def _notify(self, _, data):
+        self._rx.put_nowait(bytes(data))
+
+    def _send(self, packet):
+        for i in range(0, len(packet), self.mtu):
+            self._run(self._client.write_gatt_char(SMP_CHARACTERISTIC,
+                                                   packet[i:i + self.mtu], response=False))
+
+    def _receive(self):
+        packet = b""
+
+        while (len(packet) < _HDR_SIZE or
+               len(packet) < _HDR_SIZE + struct.unpack(">H", packet[2:4])[0]):
+            try:
+                packet += self._run(asyncio.wait_for(self._rx.get(), self._timeout))
+            except asyncio.TimeoutError:
+                raise SmpError("timeout waiting for response") from None
+
+        return packet
@@ -0,0 +1,183 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Minimal SMP (mcumgr) client for the serial and shell transports.
+
+Only what the course scripts need: send a request to a group/command and
+return the decoded CBOR response. Requires pyserial and cbor2. SmpRawSerial
+exchanges the raw packets of common/smp_raw/smp_raw_uart.c instead. Other
+transports derive from SmpClient, see smp_ble.py.
+"""
+
+import base64
+import struct
+
+import cbor2
+import serial
+
+OP_READ = 0
+OP_WRITE = 2
+_OP_RSP = 1
+_SMP_V2 = 1 << 3
+
+_FRAME_START = b"\x06\x09"
+_FRAME_CONT = b"\x04\x14"
+# Frames are at most 127 bytes: 2 byte marker, base64 payload and newline
+_FRAME_B64_MAX = 124
+
+
+def _crc16_ccitt(data, crc=0):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+class SmpError(Exception):
+    """Raised when the device returns an error or an unexpected response."""
+
+
+class SmpClient:
+    """SMP requests and responses, the transport sends and receives packets."""
+
+    def __init__(self):
+        self._seq = 0
+
+    def close(self):
+        pass
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def request(self, op, group, command, payload=None):
+        """Send a request and return the response map."""
+        return self.response(self.send(op, group, command, payload))
+
+    def send(self, op, group, command, payload=None):
+        """Send a request without waiting, return what response() needs.
+
+        Several requests can be in flight, their responses are read in order.
+        """
+        body = cbor2.dumps(payload if payload is not None else {})
+        hdr = struct.pack(">BBHHBB", op | _SMP_V2, 0, len(body), group,
+                          self._seq, command)
+        seq = self._seq
+        self._seq = (self._seq + 1) & 0xFF
+
+        self._send(hdr + body)
+
+        return op, group, command, seq
+
+    def response(self, request):
+        """Wait for the response map of a request sent with send()."""
+        op, group, command, seq = request
+
+        while True:
+            packet = self._receive()
+            r_op, _, r_len, r_group, r_seq, r_cmd = struct.unpack(
+                ">BBHHBB", packet[:8])
+            if r_seq == seq and r_group == group and r_cmd == command:
+                break
+
+        if (r_op & 0x07) != op + _OP_RSP:
+            raise SmpError(f"unexpected response op {r_op}")
+
+        rsp = cbor2.loads(packet[8:8 + r_len])
+        if "rc" in rsp and rsp["rc"] != 0:
+            raise SmpError(f"group {group} command {command}: rc {rsp['rc']}")
+        if "err" in rsp:
+            raise SmpError(f"group {group} command {command}: {rsp['err']}")
+
+        return rsp
+
+    def _send(self, packet):
+        raise NotImplementedError
+
+    def _receive(self):
+        raise NotImplementedError
+
+
+class SmpSerial(SmpClient):
+    """SMP client on a serial port using the console framing."""
+
+    def __init__(self, port, baudrate=115200, timeout=5.0):
+        super().__init__()
+        self._ser = serial.Serial(port, baudrate, timeout=timeout)
+
+    def close(self):
+        self._ser.close()
+
+    def _send(self, packet):
+        data = packet + struct.pack(">H", _crc16_ccitt(packet))
+        encoded = base64.b64encode(struct.pack(">H", len(data)) + data)
+
+        marker = _FRAME_START
+        while encoded:
+            chunk, encoded = encoded[:_FRAME_B64_MAX], encoded[_FRAME_B64_MAX:]
+            self._ser.write(marker + chunk + b"\n")
+            marker = _FRAME_CONT
+
+    def _receive(self):
+        encoded = b""
+        expected = None
+
+        while True:
+            line = self._ser.readline()
+            if not line:
+                raise SmpError("timeout waiting for response")
+
+            # The shell transport shares the port with log output
+            idx = max(line.find(_FRAME_START), line.find(_FRAME_CONT))
+            if idx < 0:
+                continue
+            marker, chunk = line[idx:idx + 2], line[idx + 2:].strip()
+
+            if marker == _FRAME_START:
+                encoded = b""
+                expected = None
+            elif expected is None and not encoded:
+                continue
+
+            encoded += chunk
+            decoded = base64.b64decode(encoded[:len(encoded) // 4 * 4])
+            if expected is None and len(decoded) >= 2:
+                expected = struct.unpack(">H", decoded[:2])[0]
+
+            if expected is not None and len(decoded) >= expected + 2:
+                data = decoded[2:2 + expected]
+                if _crc16_ccitt(data[:-2]) != struct.unpack(">H", data[-2:])[0]:
+                    raise SmpError("CRC mismatch in response")
+                return data[:-2]
+
+
+class SmpRawSerial(SmpClient):
+    """SMP client on a serial port carrying raw SMP packets."""
+
+    def __init__(self, port, timeout=5.0):
+        super().__init__()
+        self._ser = serial.Serial(port, timeout=timeout)
+        self._ser.reset_input_buffer()
+
+    def close(self):
+        self._ser.close()
+
+    def _send(self, packet):
+        self._ser.write(packet)
+
+    def _read(self, size):
+        data = self._ser.read(size)
+        if len(data) < size:
+            raise SmpError("timeout waiting for response")
+        return data
+
+    def _receive(self):
+        hdr = self._read(8)
+        return hdr + self._read(struct.unpack(">H", hdr[2:4])[0])
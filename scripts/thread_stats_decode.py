@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Decode thread_stats records from a log capture or shell output.
+
+Samples built with common/thread_stats/overlay-thread-stats.conf log every
+record as a hex dump and print the last one with "thread_stats record".
+This script extracts the records from such output and prints them as
+tables, or as CSV with one line per thread and queue for plotting.
+
+Examples:
+    thread_stats_decode.py capture.txt
+    thread_stats_decode.py --csv capture.txt > stats.csv
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+HDR = struct.Struct("<BBBBIHH")
+THREAD = struct.Struct("<8sbBHHH")
+QUEUE = struct.Struct("<8sHHHH")
+VERSION = 1
+
+# Hex dump lines, with an optional "00000000:" offset and an ASCII column
+HEX_LINE = re.compile(r"^\s*(?:[0-9a-fA-F]{8}:)?\s*((?:[0-9a-fA-F]{2}\s+)+)")
+
+
+def extract_records(lines):
+    """Yield the byte strings of the hex dumps following a record marker."""
+    current = None
+
+    for line in lines:
+        if "thread_stats" in line and "record" in line:
+            if current:
+                yield bytes(current)
+            current = bytearray()
+            continue
+
+        if current is None:
+            continue
+
+        match = HEX_LINE.match(line.split("|")[0] + " ")
+        if match:
+            current += bytes(int(b, 16) for b in match.group(1).split())
+        elif current:
+            yield bytes(current)
+            current = None
+
+    if current:
+        yield bytes(current)
+
+
+def name(raw):
+    return raw.split(b"\0")[0].decode(errors="replace")
+
+
+def decode(data):
+    """Return the header, threads and queues of a record."""
+    version, thread_count, queue_count, _, uptime, cpu_load, period = HDR.unpack_from(data)
+    if version != VERSION:
+        raise ValueError(f"unsupported record version {version}")
+
+    pos = HDR.size
+    threads = []
+    for _ in range(thread_count):
+        tname, prio, _, load, size, unused = THREAD.unpack_from(data, pos)
+        threads.append((name(tname), prio, load, size, unused))
+        pos += THREAD.size
+
+    queues = []
+    for _ in range(queue_count):
+        qname, used, peak, capacity, _ = QUEUE.unpack_from(data, pos)
+        queues.append((name(qname), used, peak, capacity))
+        pos += QUEUE.size
+
+    return (uptime, period, cpu_load), threads, queues
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"), default=sys.stdin)
+    parser.add_argument("--csv", action="store_true", help="print CSV instead of tables")
+    args = parser.parse_args()
+
+    if args.csv:
+        print("uptime_ms,kind,name,load_permille,used,size_or_capacity,free_or_peak")
+
+    for data in extract_records(args.input):
+        try:
+            (uptime, period, cpu_load), threads, queues = decode(data)
+        except (struct.error, ValueError) as e:
+            print(f"Skipping record: {e}", file=sys.stderr)
+            continue
+
+        if args.csv:
+            print(f"{uptime},cpu,,{cpu_load},,,")
+            for tname, _, load, size, unused in threads:
+                print(f"{uptime},thread,{tname},{load},{size - unused},{size},{unused}")
+            for qname, used, peak, capacity in queues:
+                print(f"{uptime},queue,{qname},,{used},{capacity},{peak}")
+            continue
+
+        print(f"Uptime {uptime} ms, period {period} ms, CPU load {cpu_load / 10:.1f} %")
+        for tname, prio, load, size, unused in threads:
+            print(f"  {tname:8} prio {prio:4} load {load / 10:5.1f} % "
+                  f"stack {size - unused:5}/{size:<5} used")
+        for qname, used, peak, capacity in queues:
+            print(f"  {qname:8} queue {used:5} used, peak {peak}, capacity {capacity}")
+
+
+if __name__ == "__main__":
+    main()
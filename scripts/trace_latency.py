@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Per-stage latency histograms from a CTF trace of a course sample.
+
+Samples built with common/trace/overlay-tracing-ctf.conf emit a named
+event at both ends of every pipeline stage, with the item sequence number
+in arg0 and 0 (begin) or 1 (end) in arg1, see devacademy/trace_points.h.
+This script pairs them and prints the latency distribution of each stage.
+
+Capture a trace on native_sim:
+    west build -b native_sim l1/l1_e1_sol -- \\
+        -DEXTRA_CONF_FILE=../../common/trace/overlay-tracing-ctf.conf
+    mkdir trace && cp $ZEPHYR_BASE/subsys/tracing/ctf/tsdl/metadata trace/
+    build/zephyr/zephyr.exe -trace-file=trace/channel0_0 -stop_at=60
+    trace_latency.py trace
+
+With --max-p99-us the script exits with an error if the 99th percentile of
+a stage exceeds the limit, for use in CI. Requires the babeltrace2 Python
+bindings (bt2).
+"""
+
+import argparse
+import math
+import sys
+from collections import defaultdict
+
+import bt2
+
+BOUNDARY_BEGIN = 0
+BOUNDARY_END = 1
+HISTOGRAM_WIDTH = 50
+
+
+def read_stage_latencies(trace_dir):
+    """Return {stage: [latency in ns]} and the number of unmatched ends."""
+    pending = {}
+    latencies = defaultdict(list)
+    unmatched = 0
+
+    for msg in bt2.TraceCollectionMessageIterator(str(trace_dir)):
+        if type(msg) is not bt2._EventMessageConst or msg.event.name != "named_event":
+            continue
+
+        payload = msg.event.payload_field
+        stage = str(payload["name"])
+        seq = int(payload["arg0"])
+        boundary = int(payload["arg1"])
+        ts = msg.default_clock_snapshot.ns_from_origin
+
+        if boundary == BOUNDARY_BEGIN:
+            pending[(stage, seq)] = ts
+        elif boundary == BOUNDARY_END:
+            start = pending.pop((stage, seq), None)
+            if start is None:
+                unmatched += 1
+            else:
+                latencies[stage].append(ts - start)
+
+    return latencies, unmatched
+
+
+def percentile(values, pct):
+    """Nearest-rank percentile of sorted values."""
+    rank = max(math.ceil(pct / 100 * len(values)), 1)
+    return values[rank - 1]
+
+
+def print_histogram(values):
+    """Print a histogram with power of two microsecond buckets."""
+    buckets = defaultdict(int)
+    for value in values:
+        us = value / 1000
+        buckets[0 if us < 1 else int(math.log2(us)) + 1] += 1
+
+    peak = max(buckets.values())
+    for bucket in range(min(buckets), max(buckets) + 1):
+        low = 0 if bucket == 0 else 2 ** (bucket - 1)
+        high = 2 ** bucket
+        count = buckets.get(bucket, 0)
+        bar = "#" * math.ceil(count * HISTOGRAM_WIDTH / peak) if count else ""
+        print(f"    {low:>8} - {high:<8} us {count:>7} {bar}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("trace_dir", help="directory with the CTF metadata and stream")
+    parser.add_argument("-s", "--stage", action="append",
+                        help="only report this stage, can be repeated")
+    parser.add_argument("--no-histogram", action="store_true")
+    parser.add_argument("--max-p99-us", type=float,
+                        help="fail if the p99 latency of a stage exceeds this value")
+    args = parser.parse_args()
+
+    latencies, unmatched = read_stage_latencies(args.trace_dir)
+    if not latencies:
+        sys.exit("No stage trace points found, was the sample built with "
+                 "overlay-tracing-ctf.conf?")
+
+    failed = []
+    for stage in sorted(latencies):
+        if args.stage and stage not in args.stage:
+            continue
+
+        values = sorted(latencies[stage])
+        p99 = percentile(values, 99)
+        print(f"{stage}: {len(values)} items, min {values[0] / 1000:.1f} us, "
+              f"p50 {percentile(values, 50) / 1000:.1f} us, "
+              f"p90 {percentile(values, 90) / 1000:.1f} us, "
+              f"p99 {p99 / 1000:.1f} us, max {values[-1] / 1000:.1f} us")
+        if not args.no_histogram:
+            print_histogram(values)
+
+        if args.max_p99_us is not None and p99 / 1000 > args.max_p99_us:
+            failed.append(stage)
+
+    if unmatched:
+        print(f"{unmatched} stage ends without a begin (trace started mid-stage "
+              "or events were dropped)", file=sys.stderr)
+
+    if failed:
+        sys.exit(f"p99 latency above {args.max_p99_us} us: {', '.join(failed)}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Upload an image over USB with several requests in flight and report KB/s.
+
+For l9_e4_sol built with overlay-usb-dfu-fast.conf and usb-dfu-fast.overlay,
+which add a second CDC ACM port carrying raw SMP packets:
+
+    usb_dfu_bench.py /dev/ttyACM1 build/l9_e4_sol/zephyr/zephyr.signed.bin
+    usb_dfu_bench.py /dev/ttyACM1 app.bin --uart /dev/ttyACM0
+
+The upload is timed from the first request to the last response, sent once
+the last byte is in flash. --uart uploads the image again over the
+console framing of the first port, one request at a time, to compare.
+"""
+
+import argparse
+import collections
+import hashlib
+import sys
+import time
+
+from smp_serial import OP_WRITE, SmpError, SmpRawSerial, SmpSerial
+
+GROUP_IMAGE = 1
+ID_IMAGE_UPLOAD = 1
+
+
+def upload(smp, image, chunk, window):
+    """Upload image with up to window requests in flight, return the seconds taken."""
+    start = time.monotonic()
+    in_flight = collections.deque()
+
+    # The first request sets the upload up, the slot may be erased meanwhile
+    rsp = smp.request(OP_WRITE, GROUP_IMAGE, ID_IMAGE_UPLOAD,
+                      {"image": 0, "off": 0, "len": len(image), "data": image[:chunk],
+                       "sha": hashlib.sha256(image).digest()})
+    off = next_off = rsp["off"]
+
+    while off < len(image):
+        while len(in_flight) < window and next_off < len(image):
+            data = image[next_off:next_off + chunk]
+            in_flight.append((smp.send(OP_WRITE, GROUP_IMAGE, ID_IMAGE_UPLOAD,
+                                       {"off": next_off, "data": data}),
+                              next_off + len(data)))
+            next_off += len(data)
+
+        request, expected = in_flight.popleft()
+        off = smp.response(request)["off"]
+
+        # A lost or rejected request: drain the ones in flight and go on from the device
+        if off != expected:
+            while in_flight:
+                off = smp.response(in_flight.popleft()[0])["off"]
+            next_off = off
+
+    return time.monotonic() - start
+
+
+def report(label, size, seconds):
+    print(f"{label}: {size} bytes in {seconds:.2f} s, {size / 1024 / seconds:.1f} KB/s")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="CDC ACM port with raw SMP packets")
+    parser.add_argument("image", help="signed image")
+    parser.add_argument("-c", "--chunk", type=int, default=4096,
+                        help="data bytes per request (default: %(default)s)")
+    parser.add_argument("-n", "--window", type=int, default=4,
+                        help="requests in flight (default: %(default)s)")
+    parser.add_argument("--uart", metavar="PORT",
+                        help="also upload over the UART transport on this port")
+    parser.add_argument("--uart-chunk", type=int, default=128,
+                        help="data bytes per UART transport request (default: %(default)s)")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    try:
+        with SmpRawSerial(args.port) as smp:
+            raw_s = upload(smp, image, args.chunk, args.window)
+        report(f"raw, {args.chunk} byte chunks, {args.window} in flight", len(image), raw_s)
+
+        if args.uart:
+            with SmpSerial(args.uart) as smp:
+                uart_s = upload(smp, image, args.uart_chunk, 1)
+            report(f"UART transport, {args.uart_chunk} byte chunks", len(image), uart_s)
+            print(f"{uart_s / raw_s:.1f} times faster")
+    except SmpError as e:
+        sys.exit(str(e))
+
+
+if __name__ == "__main__":
+    main()